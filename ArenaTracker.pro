@@ -26,6 +26,7 @@ SOURCES += Sources/main.cpp\
     Sources/arenahandler.cpp \
     Sources/secretshandler.cpp \
     Sources/drafthandler.cpp \
+    Sources/capturebenchmark.cpp \
     Sources/heartharenamentor.cpp \
     Sources/utility.cpp \
     Sources/Cards/deckcard.cpp \
@@ -77,7 +78,12 @@ SOURCES += Sources/main.cpp\
     Sources/Widgets/lavabutton.cpp \
     Sources/Widgets/draftherowindow.cpp \
     Sources/twitchhandler.cpp \
-    Sources/Widgets/twitchbutton.cpp
+    Sources/Widgets/twitchbutton.cpp \
+    Sources/Utils/cardtable.cpp \
+    Sources/Utils/histcache.cpp \
+    Sources/Utils/histmatcher.cpp \
+    Sources/Utils/screenlocator.cpp \
+    Sources/Utils/bombprobabilities.cpp
 
 HEADERS  += Sources/mainwindow.h \
     Sources/logloader.h \
@@ -89,6 +95,7 @@ HEADERS  += Sources/mainwindow.h \
     Sources/arenahandler.h \
     Sources/secretshandler.h \
     Sources/drafthandler.h \
+    Sources/capturebenchmark.h \
     Sources/heartharenamentor.h \
     Sources/utility.h \
     Sources/Cards/deckcard.h \
@@ -147,7 +154,12 @@ HEADERS  += Sources/mainwindow.h \
     Sources/Widgets/lavabutton.h \
     Sources/Widgets/draftherowindow.h \
     Sources/twitchhandler.h \
-    Sources/Widgets/twitchbutton.h
+    Sources/Widgets/twitchbutton.h \
+    Sources/Utils/cardtable.h \
+    Sources/Utils/histcache.h \
+    Sources/Utils/histmatcher.h \
+    Sources/Utils/screenlocator.h \
+    Sources/Utils/bombprobabilities.h
 
 FORMS    += mainwindow.ui
 
@@ -7,6 +7,7 @@
 bool DeckCard::drawClassColor = false;
 bool DeckCard::drawSpellWeaponColor = false;
 int DeckCard::cardHeight = 35;
+int DeckCard::drawCacheGeneration = 0;
 
 
 DeckCard::DeckCard(QString code, bool outsider)
@@ -143,8 +144,17 @@ void DeckCard::draw()
 }
 
 
+//Las filas ya dibujadas se guardan en QPixmapCache, la clave incluye todo lo que afecta al dibujo.
+//Al cambiar de tema o descargar una imagen se llama a clearDrawCache.
 QPixmap DeckCard::draw(int total, bool drawRarity, QColor nameColor, bool resize)
 {
+    const QString key = "row/" + QString::number(drawCacheGeneration) + "/" + code + "/" + createdByCode + "/" + name + "/" +
+            QString::number(total) + "/" + QString::number(drawRarity) + "/" + QString::number(nameColor.rgba()) + "/" +
+            QString::number(resize?cardHeight:-1) + "/" + QString::number(topManaLimit) + QString::number(bottomManaLimit) +
+            QString::number(outsider) + QString::number(drawClassColor) + QString::number(drawSpellWeaponColor);
+    QPixmap cached;
+    if(QPixmapCache::find(key, &cached))    return cached;
+
     QFont font(ThemeHandler::cardsFont());
     font.setBold(true);
     font.setKerning(true);
@@ -183,7 +193,7 @@ QPixmap DeckCard::draw(int total, bool drawRarity, QColor nameColor, bool resize
         else                                    target = QRectF(100,6,100,25);
 
         if(name == "unknown")   painter.drawPixmap(target, QPixmap(ThemeHandler::unknownFile()), source);
-        else    painter.drawPixmap(target, QPixmap(Utility::hscardsPath() + "/" + code + ".png"), source);
+        else    painter.drawPixmap(target, Utility::getCardPixmap(code), source);
 
         //Background and #cards
         painter.setPen(QPen(BLACK));
@@ -263,13 +273,20 @@ QPixmap DeckCard::draw(int total, bool drawRarity, QColor nameColor, bool resize
     painter.end();
 
     //Adapt to size
-    if(resize)  return resizeCardHeight(canvas);
-    else        return canvas;
+    if(resize)  canvas = resizeCardHeight(canvas);
+    QPixmapCache::insert(key, canvas);
+    return canvas;
 }
 
 
 QPixmap DeckCard::drawCustomCard(QString customCode, QString customText)
 {
+    const QString key = "rowBy/" + QString::number(drawCacheGeneration) + "/" + customCode + "/" + customText + "/" + name + "/" +
+            QString::number(type) + "/" + QString::number(cardHeight) + "/" +
+            QString::number(outsider) + QString::number(drawSpellWeaponColor);
+    QPixmap cached;
+    if(QPixmapCache::find(key, &cached))    return cached;
+
     QFont font(ThemeHandler::cardsFont());
     font.setBold(true);
     font.setKerning(true);
@@ -297,7 +314,7 @@ QPixmap DeckCard::drawCustomCard(QString customCode, QString customText)
         {
             if(type==MINION)        source = QRectF(46,72,100,25);
             else                    source = QRectF(46,98,100,25);
-            painter.drawPixmap(target, QPixmap(Utility::hscardsPath() + "/" + customCode + ".png"), source);
+            painter.drawPixmap(target, Utility::getCardPixmap(customCode), source);
         }
         else
         {
@@ -339,7 +356,9 @@ QPixmap DeckCard::drawCustomCard(QString customCode, QString customText)
         Utility::drawShadowText(painter, font, name, 14 + customTextWide, 20, false);
     painter.end();
 
-    return resizeCardHeight(canvas);
+    canvas = resizeCardHeight(canvas);
+    QPixmapCache::insert(key, canvas);
+    return canvas;
 }
 
 
@@ -450,3 +469,10 @@ int DeckCard::getCardWidth()
 {
     return (cardHeight<=35)?218:static_cast<int>(cardHeight/35.0*218);
 }
+
+
+//Las filas anteriores dejan de encontrarse y QPixmapCache las va descartando.
+void DeckCard::clearDrawCache()
+{
+    DeckCard::drawCacheGeneration++;
+}
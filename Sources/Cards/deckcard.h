@@ -43,6 +43,7 @@ protected:
 
     static bool drawClassColor, drawSpellWeaponColor;
     static int cardHeight;
+    static int drawCacheGeneration;
 
 private:
     bool topManaLimit, bottomManaLimit;
@@ -77,6 +78,7 @@ public:
     static void setCardHeight(int value);
     static int getCardHeight();
     static int getCardWidth();
+    static void clearDrawCache();
 };
 
 #endif // DECKCARD_H
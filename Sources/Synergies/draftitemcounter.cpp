@@ -76,8 +76,10 @@ void DraftItemCounter::setTheme(QPixmap pixmap, int iconWidth, bool inDraftMecha
 void DraftItemCounter::reset()
 {
     this->counter = 0;
-    this->deckCardList.clear();
-    this->deckCardListSyn.clear();
+    this->codeList.clear();
+    this->codeListSyn.clear();
+    this->codeTotals.clear();
+    this->codeTotalsSyn.clear();
 
     if(labelIcon != nullptr && labelCounter != nullptr)
     {
@@ -135,22 +137,7 @@ void DraftItemCounter::increase(int numIncrease, int draftedCardsCount)
 }
 void DraftItemCounter::increase(const QString &code, bool count)
 {
-    bool duplicatedCard = false;
-    for(DeckCard &deckCard: deckCardList)
-    {
-        if(deckCard.getCode() == code)
-        {
-            deckCard.total++;
-            deckCard.remaining = deckCard.total;
-            duplicatedCard = true;
-            break;
-        }
-    }
-
-    if(!duplicatedCard)
-    {
-        deckCardList.append(DeckCard(code));
-    }
+    addCode(code, codeList, codeTotals);
 
     if(labelIcon != nullptr && labelCounter != nullptr && count)
     {
@@ -167,64 +154,49 @@ void DraftItemCounter::increase(const QString &code, bool count)
 
 void DraftItemCounter::increaseSyn(const QString &code)
 {
-    bool duplicatedCard = false;
-    for(DeckCard &deckCard: deckCardListSyn)
-    {
-        if(deckCard.getCode() == code)
-        {
-            deckCard.total++;
-            deckCard.remaining = deckCard.total;
-            duplicatedCard = true;
-            break;
-        }
-    }
+    addCode(code, codeListSyn, codeTotalsSyn);
+}
 
-    if(!duplicatedCard)
+
+void DraftItemCounter::addCode(const QString &code, QStringList &codes, QHash<QString, int> &totals)
+{
+    QHash<QString, int>::iterator it = totals.find(code);
+    if(it != totals.end())  it.value()++;
+    else
     {
-        deckCardListSyn.append(DeckCard(code));
+        codes.append(code);
+        totals.insert(code, 1);
     }
 }
 
 
 bool DraftItemCounter::insertCode(const QString code, QMap<QString,int> &synergies)
 {
-    for(DeckCard &deckCard: deckCardList)
-    {
-        if(code == deckCard.getCode())
-        {
-            if(!synergies.contains(code))
-            {
-                synergies[code] = deckCard.total;
-            }
-            return true;
-        }
-    }
-    return false;
+    QHash<QString, int>::const_iterator it = codeTotals.constFind(code);
+    if(it == codeTotals.cend())     return false;
+
+    if(!synergies.contains(code))   synergies[code] = it.value();
+    return true;
 }
 
 
 void DraftItemCounter::insertCards(QMap<QString,int> &synergies)
 {
-    for(DeckCard &deckCard: deckCardList)
-    {
-        QString code = deckCard.getCode();
-        if(!synergies.contains(code))
-        {
-            synergies[code] = deckCard.total;
-        }
-    }
+    insertCodes(codeList, codeTotals, synergies);
 }
 
 
 void DraftItemCounter::insertSynCards(QMap<QString,int> &synergies)
 {
-    for(DeckCard &deckCard: deckCardListSyn)
+    insertCodes(codeListSyn, codeTotalsSyn, synergies);
+}
+
+
+void DraftItemCounter::insertCodes(const QStringList &codes, const QHash<QString, int> &totals, QMap<QString, int> &synergies)
+{
+    for(const QString &code: codes)
     {
-        QString code = deckCard.getCode();
-        if(!synergies.contains(code))
-        {
-            synergies[code] = deckCard.total;
-        }
+        if(!synergies.contains(code))   synergies[code] = totals.value(code);
     }
 }
 
@@ -243,6 +215,13 @@ int DraftItemCounter::count()
 
 QList<DeckCard> DraftItemCounter::getDeckCardList()
 {
+    QList<DeckCard> deckCardList;
+    for(const QString &code: codeList)
+    {
+        DeckCard deckCard(code);
+        deckCard.total = deckCard.remaining = codeTotals.value(code);
+        deckCardList.append(deckCard);
+    }
     return deckCardList;
 }
 
@@ -254,7 +233,7 @@ void DraftItemCounter::sendIconEnter()
     QRect labelRect = QRect(topLeft, bottomRight);
 
     QMap<int,DeckCard> deckCardMap;
-    for(DeckCard &deckCard: deckCardList)   deckCardMap.insertMulti(deckCard.getCost(), deckCard);
+    for(DeckCard &deckCard: getDeckCardList())   deckCardMap.insertMulti(deckCard.getCost(), deckCard);
     QList<DeckCard> deckCardOrderedList = deckCardMap.values();
 
     emit iconEnter(deckCardOrderedList, labelRect);
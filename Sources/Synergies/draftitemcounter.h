@@ -21,11 +21,15 @@ private:
     HoverLabel *labelIcon;
     QLabel *labelCounter;
     int counter;
-    QList<DeckCard> deckCardList, deckCardListSyn;
+    //Indice inverso: cartas draft (code --> copias) que aportan Gen/Syn a este counter.
+    QStringList codeList, codeListSyn;
+    QHash<QString, int> codeTotals, codeTotalsSyn;
 
 //Metodos
 private:
     void init(QHBoxLayout *hLayout, bool iconHover);
+    static void addCode(const QString &code, QStringList &codes, QHash<QString, int> &totals);
+    static void insertCodes(const QStringList &codes, const QHash<QString, int> &totals, QMap<QString, int> &synergies);
 
 public:
     void reset();
@@ -39,24 +39,8 @@ void StatSynergies::updateStatsMapSyn(const StatSyn &statSyn, QString &code)
 
 void StatSynergies::appendStatValue(bool appendToSyn, int statValue, QString &code)
 {
-    QMap<int, QList<DeckCard>> &statsMap = (appendToSyn?this->statsMapSyn:this->statsMap);
-
-    bool duplicatedCard = false;
-    for(DeckCard &deckCard: statsMap[statValue])
-    {
-        if(deckCard.getCode() == code)
-        {
-            deckCard.total++;
-            deckCard.remaining = deckCard.total;
-            duplicatedCard = true;
-            break;
-        }
-    }
-
-    if(!duplicatedCard)
-    {
-        statsMap[statValue].append(DeckCard(code));
-    }
+    QMap<int, QHash<QString, int>> &statsMap = (appendToSyn?this->statsMapSyn:this->statsMap);
+    statsMap[statValue][code]++;
 }
 
 
@@ -68,16 +52,10 @@ void StatSynergies::insertStatCards(const StatSyn &statSyn, QMap<QString,int> &s
             insertCards(false, statSyn.statValue, synergies);
         break;
         case S_LOWER_IGUAL:
-            for(int i = statSyn.statValue; i >= 0; i--)
-            {
-                insertCards(false, i, synergies);
-            }
+            insertCards(false, 0, statSyn.statValue, synergies);
         break;
         case S_HIGHER_EQUAL:
-            for(int i = statSyn.statValue; i <= 15; i++)
-            {
-                insertCards(false, i, synergies);
-            }
+            insertCards(false, statSyn.statValue, 15, synergies);
         break;
     }
 }
@@ -85,29 +63,53 @@ void StatSynergies::insertStatCards(const StatSyn &statSyn, QMap<QString,int> &s
 
 void StatSynergies::insertCards(bool insertSyn, int statValue, QMap<QString,int> &synergies)
 {
-    QMap<int, QList<DeckCard>> &statsMap = (insertSyn?this->statsMapSyn:this->statsMap);
-    if(!statsMap.contains(statValue))    return;
+    insertCards(insertSyn, statValue, statValue, synergies);
+}
 
-    for(DeckCard &deckCard: statsMap[statValue])
+
+void StatSynergies::insertCards(bool insertSyn, int minValue, int maxValue, QMap<QString,int> &synergies)
+{
+    const QMap<int, QHash<QString, int>> &statsMap = (insertSyn?this->statsMapSyn:this->statsMap);
+
+    QMap<int, QHash<QString, int>>::const_iterator end = statsMap.upperBound(maxValue);
+    for(QMap<int, QHash<QString, int>>::const_iterator it = statsMap.lowerBound(minValue); it != end; it++)
     {
-        QString code = deckCard.getCode();
-        if(!synergies.contains(code))
+        for(QHash<QString, int>::const_iterator itCode = it->cbegin(); itCode != it->cend(); itCode++)
         {
-            synergies[code] = deckCard.total;
+            if(!synergies.contains(itCode.key()))  synergies[itCode.key()] = itCode.value();
         }
     }
 }
 
 
+//statPoint es un stat real o Gen (op ignorado), statSyn una regla Syn.
+bool StatSynergies::isStatSynMatch(const StatSyn &statSyn, const StatSyn &statPoint)
+{
+    if(statSyn.cardType != statPoint.cardType || statSyn.statKind != statPoint.statKind)   return false;
+
+    int value = statPoint.statValue;
+    switch(statSyn.op)
+    {
+        case S_EQUAL:
+            return value == statSyn.statValue;
+        case S_LOWER_IGUAL:
+            return value >= 0 && value <= statSyn.statValue;
+        case S_HIGHER_EQUAL:
+            return value >= statSyn.statValue && value <= 15;
+    }
+    return false;
+}
+
+
 void StatSynergies::qDebugContents()
 {
     qDebug()<<"**StatsMinions**";
     for(const int key: statsMap.keys())
     {
         qDebug()<<'['<<key<<']'<<endl;
-        for(DeckCard &deckCard: statsMap[key])
+        for(const QString &code: statsMap[key].keys())
         {
-            qDebug()<<'\t'<<deckCard.getName();
+            qDebug()<<'\t'<<DeckCard(code).getName();
         }
     }
 
@@ -115,9 +117,9 @@ void StatSynergies::qDebugContents()
     for(const int key: statsMapSyn.keys())
     {
         qDebug()<<'['<<key<<']'<<endl;
-        for(DeckCard &deckCard: statsMapSyn[key])
+        for(const QString &code: statsMapSyn[key].keys())
         {
-            qDebug()<<'\t'<<deckCard.getName();
+            qDebug()<<'\t'<<DeckCard(code).getName();
         }
     }
 }
@@ -2,6 +2,7 @@
 #define STATSYNERGIES_H
 
 #include <QObject>
+#include <QHash>
 #include "../Cards/deckcard.h"
 
 
@@ -28,17 +29,20 @@ public:
 
 //Variables
 private:
-    QMap<int, QList<DeckCard>> statsMap, statsMapSyn;
+    //Indice inverso: valor de stat --> cartas draft (code --> copias).
+    QMap<int, QHash<QString, int>> statsMap, statsMapSyn;
 
 //Metodos
 public:
     static QList<StatSyn> getStatsSynergiesFromJson(const QString &code, QMap<QString, QList<QString> > &synergyCodes);
+    static bool isStatSynMatch(const StatSyn &statSyn, const StatSyn &statPoint);
     void clear();
     void qDebugContents();
     void updateStatsMapSyn(const StatSyn &statSyn, QString &code);
     void appendStatValue(bool appendToSyn, int statValue, QString &code);
     void insertStatCards(const StatSyn &statSyn, QMap<QString, int> &synergies);
     void insertCards(bool insertSyn, int statValue, QMap<QString, int> &synergies);
+    void insertCards(bool insertSyn, int minValue, int maxValue, QMap<QString, int> &synergies);
 };
 
 #endif // STATSYNERGIES_H
@@ -0,0 +1,165 @@
+#include "bombprobabilities.h"
+#include <QVarLengthArray>
+#include <algorithm>
+#include <limits>
+
+
+//targets: golpes necesarios para matar cada objetivo (<= 0 ya muerto).
+BombProbabilities::BombProbabilities(const QList<int> &targets, int missiles)
+{
+    this->missiles = missiles;
+    this->immortals = 0;
+    this->packed = true;
+
+    for(int i=0; i<targets.count(); i++)
+    {
+        const int hits = targets[i];
+        if(hits <= 0)   deadProbs.append(1);
+        else
+        {
+            deadProbs.append(0);
+            if(hits > missiles)     immortals++;
+            else                    trackedIndexes.append(i);
+        }
+    }
+
+    //Vidas iguales contiguas para formar los grupos de objetivos intercambiables
+    std::stable_sort(trackedIndexes.begin(), trackedIndexes.end(),
+                     [&targets](int a, int b){ return targets[a] > targets[b]; });
+
+    quint64 place = 1;
+    for(int pos=0; pos<trackedIndexes.count(); pos++)
+    {
+        const int hits = targets[trackedIndexes[pos]];
+        if(pos == 0 || hits != targets[trackedIndexes[pos-1]])  groupStarts.append(pos);
+        else                                                    groupStarts.append(groupStarts.last());
+
+        radix.append(hits + 1);
+        places.append(place);
+        const quint64 radixPos = static_cast<quint64>(radix.last());
+        if(!packed)     continue;
+        if(place > std::numeric_limits<quint64>::max() / radixPos)  packed = false;
+        else                                                        place *= radixPos;
+    }
+}
+
+
+QList<float> BombProbabilities::getDeadProbs(const QList<int> &targets, int missiles)
+{
+    BombProbabilities bombProbabilities(targets, missiles);
+    if(bombProbabilities.trackedIndexes.isEmpty())  return bombProbabilities.deadProbs;
+
+    if(bombProbabilities.packed)    bombProbabilities.run<quint64>();
+    else                            bombProbabilities.run<QByteArray>();
+    return bombProbabilities.deadProbs;
+}
+
+
+template <typename Key>
+void BombProbabilities::run()
+{
+    const int numTracked = trackedIndexes.count();
+    QHash<Key, double> states;
+    Key key;
+    initKey(key);
+    states[key] = 1;
+
+    QVarLengthArray<int, 32> digits(numTracked);
+    for(int i=0; i<missiles; i++)
+    {
+        QHash<Key, double> newStates;
+        newStates.reserve(states.count() * 2);
+
+        for(typename QHash<Key, double>::const_iterator it = states.cbegin(); it != states.cend(); it++)
+        {
+            int livingTargets = immortals;
+            for(int pos=0; pos<numTracked; pos++)
+            {
+                digits[pos] = getDigit(it.key(), pos);
+                if(digits[pos] > 0)     livingTargets++;
+            }
+
+            //Sin objetivos vivos el resto de misiles no tiene efecto
+            if(livingTargets == 0)
+            {
+                newStates[it.key()] += it.value();
+                continue;
+            }
+
+            const double hitProb = it.value() / livingTargets;
+            if(immortals > 0)   newStates[it.key()] += hitProb * immortals;
+
+            //Golpear cualquier objetivo de un grupo con la misma vida restante da el mismo estado,
+            //se resta al ultimo de ellos para mantener el orden descendente dentro del grupo.
+            int pos = 0;
+            while(pos < numTracked)
+            {
+                int end = pos + 1;
+                while(end < numTracked && groupStarts[end] == groupStarts[pos] && digits[end] == digits[pos])   end++;
+                if(digits[pos] > 0)     newStates[hitKey(it.key(), end-1)] += hitProb * (end - pos);
+                pos = end;
+            }
+        }
+
+        states.swap(newStates);
+    }
+
+    //Dentro de un grupo todos los objetivos tienen la misma probabilidad de morir
+    QVector<double> groupDeads(numTracked, 0);
+    QVector<int> groupSizes(numTracked, 0);
+    for(int pos=0; pos<numTracked; pos++)   groupSizes[groupStarts[pos]]++;
+
+    for(typename QHash<Key, double>::const_iterator it = states.cbegin(); it != states.cend(); it++)
+    {
+        for(int pos=0; pos<numTracked; pos++)
+        {
+            if(getDigit(it.key(), pos) == 0)    groupDeads[groupStarts[pos]] += it.value();
+        }
+    }
+
+    for(int pos=0; pos<numTracked; pos++)
+    {
+        const int group = groupStarts[pos];
+        deadProbs[trackedIndexes[pos]] = static_cast<float>(groupDeads[group] / groupSizes[group]);
+    }
+}
+
+
+void BombProbabilities::initKey(quint64 &key) const
+{
+    key = 0;
+    for(int pos=0; pos<radix.count(); pos++)    key += static_cast<quint64>(radix[pos] - 1) * places[pos];
+}
+
+
+void BombProbabilities::initKey(QByteArray &key) const
+{
+    key.resize(radix.count());
+    for(int pos=0; pos<radix.count(); pos++)    key[pos] = static_cast<char>(radix[pos] - 1);
+}
+
+
+int BombProbabilities::getDigit(quint64 key, int pos) const
+{
+    return static_cast<int>((key / places[pos]) % static_cast<quint64>(radix[pos]));
+}
+
+
+int BombProbabilities::getDigit(const QByteArray &key, int pos) const
+{
+    return static_cast<uchar>(key.at(pos));
+}
+
+
+quint64 BombProbabilities::hitKey(quint64 key, int pos) const
+{
+    return key - places[pos];
+}
+
+
+QByteArray BombProbabilities::hitKey(const QByteArray &key, int pos) const
+{
+    QByteArray newKey(key);
+    newKey[pos] = static_cast<char>(static_cast<uchar>(key.at(pos)) - 1);
+    return newKey;
+}
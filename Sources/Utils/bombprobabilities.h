@@ -0,0 +1,47 @@
+#ifndef BOMBPROBABILITIES_H
+#define BOMBPROBABILITIES_H
+
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QByteArray>
+
+
+//Probabilidad de morir de cada objetivo tras repartir N misiles de 1 de damage al azar entre los objetivos vivos
+//(Arcane Missiles, Avenging Wrath, Cinderstorm...).
+//Un estado es la vida restante de los objetivos que pueden morir, codificada como un entero en base mixta.
+//Los objetivos con la misma vida inicial son intercambiables: sus vidas se guardan en orden descendente
+//y cada grupo de vidas iguales genera una sola transicion, lo que reduce mucho los estados en boards grandes.
+//Los objetivos con mas vida que misiles nunca mueren y solo cuentan como vivos.
+class BombProbabilities
+{
+//Constructor
+private:
+    BombProbabilities(const QList<int> &targets, int missiles);
+
+//Variables
+private:
+    int missiles;
+    int immortals;              //Objetivos vivos que no pueden morir
+    QVector<int> trackedIndexes;//Posicion en el estado -> indice en targets, ordenados por vida inicial
+    QVector<int> groupStarts;   //Posicion en el estado -> primera posicion de su grupo de vida inicial
+    QVector<int> radix;         //Vida inicial + 1
+    QVector<quint64> places;    //Valor posicional de cada vida en la clave empaquetada
+    bool packed;                //false si los estados no caben en 64 bits, se usan claves QByteArray
+    QList<float> deadProbs;
+
+//Metodos
+private:
+    template <typename Key> void run();
+    void initKey(quint64 &key) const;
+    void initKey(QByteArray &key) const;
+    int getDigit(quint64 key, int pos) const;
+    int getDigit(const QByteArray &key, int pos) const;
+    quint64 hitKey(quint64 key, int pos) const;
+    QByteArray hitKey(const QByteArray &key, int pos) const;
+
+public:
+    static QList<float> getDeadProbs(const QList<int> &targets, int missiles);
+};
+
+#endif // BOMBPROBABILITIES_H
@@ -0,0 +1,665 @@
+#include "cardtable.h"
+#include <QtWidgets>
+#include <limits>
+
+
+CardTable::CardTable()
+{
+
+}
+
+
+template <typename T>
+static void writeEnums(QDataStream &stream, const QVector<T> &values)
+{
+    QVector<qint32> ints;
+    ints.reserve(values.count());
+    for(T value: values)    ints.append(static_cast<qint32>(value));
+    stream << ints;
+}
+
+
+template <typename T>
+static void readEnums(QDataStream &stream, QVector<T> &values)
+{
+    QVector<qint32> ints;
+    stream >> ints;
+    values.clear();
+    values.reserve(ints.count());
+    for(qint32 value: ints)     values.append(static_cast<T>(value));
+}
+
+
+void CardTable::build(const QJsonObject &cardsObject, const QString &localLang)
+{
+    const int numCards = cardsObject.count();
+
+    codes.clear();
+    costs.clear();
+    attacks.clear();
+    healths.clear();
+    dbfIds.clear();
+    armors.clear();
+    durabilities.clear();
+    overloads.clear();
+    spellDamages.clear();
+    types.clear();
+    rarities.clear();
+    classes.clear();
+    races.clear();
+    sets.clear();
+    setNames.clear();
+    typeNameIds.clear();
+    classNameIds.clear();
+    typeNames.clear();
+    classNames.clear();
+    mechanics.clear();
+    referencedTags.clear();
+    collectibles.clear();
+    standards.clear();
+    secrets.clear();
+    enNames.clear();
+    enTexts.clear();
+    enTextsLower.clear();
+
+    codes.reserve(numCards);
+    costs.reserve(numCards);
+    attacks.reserve(numCards);
+    healths.reserve(numCards);
+    dbfIds.reserve(numCards);
+    armors.reserve(numCards);
+    durabilities.reserve(numCards);
+    overloads.reserve(numCards);
+    spellDamages.reserve(numCards);
+    types.reserve(numCards);
+    rarities.reserve(numCards);
+    classes.reserve(numCards);
+    races.reserve(numCards);
+    sets.reserve(numCards);
+    typeNameIds.reserve(numCards);
+    classNameIds.reserve(numCards);
+    mechanics.reserve(numCards);
+    referencedTags.reserve(numCards);
+    collectibles.reserve(numCards);
+    standards.reserve(numCards);
+    secrets.reserve(numCards);
+    enNames.reserve(numCards);
+    enTexts.reserve(numCards);
+    enTextsLower.reserve(numCards);
+
+    for(QJsonObject::const_iterator it = cardsObject.constBegin(); it != cardsObject.constEnd(); it++)
+    {
+        const QJsonObject card = it.value().toObject();
+        const QString set = card.value("set").toString();
+        const QString type = card.value("type").toString();
+        const QString cardClass = card.value("cardClass").toString();
+
+        codes.append(it.key());
+        costs.append(intOrNoValue(card.value("cost")));
+        attacks.append(intOrNoValue(card.value("attack")));
+        healths.append(intOrNoValue(card.value("health")));
+        dbfIds.append(intOrNoValue(card.value("dbfId")));
+        armors.append(intOrNoValue(card.value("armor")));
+        durabilities.append(intOrNoValue(card.value("durability")));
+        overloads.append(intOrNoValue(card.value("overload")));
+        spellDamages.append(intOrNoValue(card.value("spellDamage")));
+        types.append(typeFromString(type));
+        rarities.append(rarityFromString(card.value("rarity").toString()));
+        classes.append(classFromString(cardClass));
+        races.append(raceFromString(card.value("race").toString()));
+        sets.append(internString(setNames, set));
+        typeNameIds.append(internString(typeNames, type));
+        classNameIds.append(internString(classNames, cardClass));
+        mechanics.append(toStringList(card.value("mechanics")));
+        referencedTags.append(toStringList(card.value("referencedTags")));
+        collectibles.append(card.value("collectible").toBool());
+        standards.append(isStandardSet(set));
+        secrets.append(mechanics.last().contains("SECRET"));
+        enNames.append(card.value("name").toObject().value("enUS").toString());
+        enTexts.append(card.value("text").toObject().value("enUS").toString());
+        enTextsLower.append(enTexts.last().toLower());
+    }
+
+    buildIndexes();
+    buildLocal(cardsObject, localLang);
+}
+
+
+//Indices inversos, no se guardan en cards.bin sino que se rehacen a partir de las columnas.
+void CardTable::buildIndexes()
+{
+    codeIds.clear();
+    enNameIds.clear();
+    dbfIdIds.clear();
+    setIds.clear();
+    collectibleIds.clear();
+    standardIds.clear();
+    codeIds.reserve(codes.count());
+    setIds.resize(setNames.count());
+
+    for(int id=0; id<codes.count(); id++)
+    {
+        codeIds[codes[id]] = id;
+        enNameIds[enNames[id]].append(id);
+        if(dbfIds[id] != CARD_NO_VALUE)     dbfIdIds.insert(dbfIds[id], id);
+        setIds[sets[id]].append(id);
+        if(collectibles[id])
+        {
+            collectibleIds.append(id);
+            if(standards[id])   standardIds.append(id);
+        }
+    }
+}
+
+
+//Nombres y textos en el idioma de HS, se rehacen al cambiar localLang.
+void CardTable::buildLocal(const QJsonObject &cardsObject, const QString &localLang)
+{
+    localNames.clear();
+    localTexts.clear();
+    localNames.reserve(codes.count());
+    localTexts.reserve(codes.count());
+
+    foreach(const QString &code, codes)
+    {
+        const QJsonObject card = cardsObject.value(code).toObject();
+        localNames.append(card.value("name").toObject().value(localLang).toString());
+        localTexts.append(card.value("text").toObject().value(localLang).toString());
+    }
+
+    buildLocalIndex();
+}
+
+
+void CardTable::buildLocalIndex()
+{
+    localNameIds.clear();
+    for(int id=0; id<localNames.count(); id++)  localNameIds[localNames[id]].append(id);
+}
+
+
+//cards.bin: cabecera (magic, CARDS_BIN_VERSION, numero de cartas y offset de cada seccion) y las secciones.
+//La seccion "base" tiene las columnas comunes y hay una seccion por idioma con sus nombres y textos,
+//al cargar solo se leen la base y el idioma de HS.
+bool CardTable::save(const QString &path, const QJsonObject &cardsObject) const
+{
+    QMap<QString, QByteArray> sections;
+    QByteArray baseData;
+    QDataStream baseStream(&baseData, QIODevice::WriteOnly);
+    baseStream.setVersion(CARDS_BIN_STREAM_VERSION);
+    baseStream << codes << costs << attacks << healths
+               << dbfIds << armors << durabilities << overloads << spellDamages;
+    writeEnums(baseStream, types);
+    writeEnums(baseStream, rarities);
+    writeEnums(baseStream, classes);
+    writeEnums(baseStream, races);
+    baseStream << sets << setNames << typeNameIds << classNameIds << typeNames << classNames
+               << mechanics << referencedTags << collectibles << standards << secrets
+               << enNames << enTexts << enTextsLower;
+    sections["base"] = baseData;
+
+    QMap<QString, QVector<QString>> langNames, langTexts;
+    for(int id=0; id<codes.count(); id++)
+    {
+        const QJsonObject card = cardsObject.value(codes[id]).toObject();
+        const QJsonObject nameObject = card.value("name").toObject();
+        const QJsonObject textObject = card.value("text").toObject();
+        for(QJsonObject::const_iterator it = nameObject.constBegin(); it != nameObject.constEnd(); it++)
+        {
+            if(!langNames.contains(it.key()))
+            {
+                langNames[it.key()].resize(codes.count());
+                langTexts[it.key()].resize(codes.count());
+            }
+            langNames[it.key()][id] = it.value().toString();
+            langTexts[it.key()][id] = textObject.value(it.key()).toString();
+        }
+    }
+
+    foreach(const QString &lang, langNames.keys())
+    {
+        QByteArray langData;
+        QDataStream langStream(&langData, QIODevice::WriteOnly);
+        langStream.setVersion(CARDS_BIN_STREAM_VERSION);
+        langStream << langNames[lang] << langTexts[lang];
+        sections[lang] = langData;
+    }
+
+    QMap<QString, qint64> offsets;
+    qint64 offset = 0;
+    for(QMap<QString, QByteArray>::const_iterator it = sections.cbegin(); it != sections.cend(); it++)
+    {
+        offsets[it.key()] = offset;
+        offset += it.value().size();
+    }
+
+    QSaveFile file(path);
+    if(!file.open(QIODevice::WriteOnly))    return false;
+    QDataStream stream(&file);
+    stream.setVersion(CARDS_BIN_STREAM_VERSION);
+    stream << quint32(CARDS_BIN_MAGIC) << qint32(CARDS_BIN_VERSION) << qint32(codes.count()) << offsets;
+    foreach(const QByteArray &section, sections)
+    {
+        stream.writeRawData(section.constData(), section.size());
+    }
+
+    if(stream.status() != QDataStream::Ok)  file.cancelWriting();
+    return file.commit();
+}
+
+
+bool CardTable::load(const QString &path, const QString &localLang)
+{
+    QFile file(path);
+    QDataStream stream;
+    int numCards;
+    if(!openSection(file, stream, "base", numCards))    return false;
+
+    stream >> codes >> costs >> attacks >> healths
+           >> dbfIds >> armors >> durabilities >> overloads >> spellDamages;
+    readEnums(stream, types);
+    readEnums(stream, rarities);
+    readEnums(stream, classes);
+    readEnums(stream, races);
+    stream >> sets >> setNames >> typeNameIds >> classNameIds >> typeNames >> classNames
+           >> mechanics >> referencedTags >> collectibles >> standards >> secrets
+           >> enNames >> enTexts >> enTextsLower;
+    if(stream.status() != QDataStream::Ok || !checkColumns(numCards))   return false;
+
+    buildIndexes();
+    return loadLocal(path, localLang);
+}
+
+
+bool CardTable::loadLocal(const QString &path, const QString &localLang)
+{
+    QFile file(path);
+    QDataStream stream;
+    int numCards;
+    if(!openSection(file, stream, localLang, numCards) || numCards != codes.count())  return false;
+
+    QVector<QString> newLocalNames, newLocalTexts;
+    stream >> newLocalNames >> newLocalTexts;
+    if(stream.status() != QDataStream::Ok ||
+        newLocalNames.count() != numCards || newLocalTexts.count() != numCards)   return false;
+
+    localNames = newLocalNames;
+    localTexts = newLocalTexts;
+    buildLocalIndex();
+    return true;
+}
+
+
+//Todas las columnas deben tener una entrada por carta y los indices a setNames/typeNames/classNames deben existir,
+//una seccion base incompleta o de otra version no se usa (se recompila desde cards.json).
+bool CardTable::checkColumns(int numCards) const
+{
+    if(codes.count() != numCards ||
+        costs.count() != numCards || attacks.count() != numCards || healths.count() != numCards ||
+        dbfIds.count() != numCards || armors.count() != numCards || durabilities.count() != numCards ||
+        overloads.count() != numCards || spellDamages.count() != numCards ||
+        types.count() != numCards || rarities.count() != numCards || classes.count() != numCards ||
+        races.count() != numCards || sets.count() != numCards ||
+        typeNameIds.count() != numCards || classNameIds.count() != numCards ||
+        mechanics.count() != numCards || referencedTags.count() != numCards ||
+        collectibles.count() != numCards || standards.count() != numCards || secrets.count() != numCards ||
+        enNames.count() != numCards || enTexts.count() != numCards || enTextsLower.count() != numCards)
+    {
+        return false;
+    }
+
+    for(int id=0; id<numCards; id++)
+    {
+        if(sets[id] >= setNames.count() || typeNameIds[id] >= typeNames.count() ||
+            classNameIds[id] >= classNames.count())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+//Comprueba la cabecera de cards.bin y deja stream al principio de la seccion.
+bool CardTable::openSection(QFile &file, QDataStream &stream, const QString &section, int &numCards)
+{
+    if(!file.open(QIODevice::ReadOnly))     return false;
+    stream.setDevice(&file);
+    stream.setVersion(CARDS_BIN_STREAM_VERSION);
+
+    quint32 magic;
+    qint32 version, count;
+    QMap<QString, qint64> offsets;
+    stream >> magic >> version;
+    if(stream.status() != QDataStream::Ok || magic != CARDS_BIN_MAGIC || version != CARDS_BIN_VERSION)   return false;
+    stream >> count >> offsets;
+    if(stream.status() != QDataStream::Ok || !offsets.contains(section))    return false;
+
+    numCards = count;
+    return file.seek(file.pos() + offsets[section]);
+}
+
+
+quint16 CardTable::internString(QStringList &strings, const QString &value)
+{
+    int index = strings.indexOf(value);
+    if(index == -1)
+    {
+        index = strings.count();
+        strings.append(value);
+    }
+    Q_ASSERT(index <= std::numeric_limits<quint16>::max());
+    return static_cast<quint16>(index);
+}
+
+
+int CardTable::intOrNoValue(const QJsonValue &value)
+{
+    if(value.isUndefined() || value.isNull())   return CARD_NO_VALUE;
+    return value.toInt();
+}
+
+
+QStringList CardTable::toStringList(const QJsonValue &value)
+{
+    QStringList list;
+    foreach(QJsonValue item, value.toArray())   list.append(item.toString());
+    return list;
+}
+
+
+int CardTable::count() const
+{
+    return codes.count();
+}
+
+
+int CardTable::getId(const QString &code) const
+{
+    return codeIds.value(code, -1);
+}
+
+
+QString CardTable::getCode(int id) const
+{
+    if(id < 0 || id >= codes.count())   return "";
+    return codes[id];
+}
+
+
+int CardTable::getCost(int id) const
+{
+    if(id < 0 || id >= codes.count())   return CARD_NO_VALUE;
+    return costs[id];
+}
+
+
+int CardTable::getAttack(int id) const
+{
+    if(id < 0 || id >= codes.count())   return CARD_NO_VALUE;
+    return attacks[id];
+}
+
+
+int CardTable::getHealth(int id) const
+{
+    if(id < 0 || id >= codes.count())   return CARD_NO_VALUE;
+    return healths[id];
+}
+
+
+CardType CardTable::getType(int id) const
+{
+    if(id < 0 || id >= codes.count())   return INVALID_TYPE;
+    return types[id];
+}
+
+
+CardRarity CardTable::getRarity(int id) const
+{
+    if(id < 0 || id >= codes.count())   return INVALID_RARITY;
+    return rarities[id];
+}
+
+
+//Codigos desconocidos son NEUTRAL, igual que una carta sin cardClass.
+CardClass CardTable::getClass(int id) const
+{
+    if(id < 0 || id >= codes.count())   return NEUTRAL;
+    return classes[id];
+}
+
+
+CardRace CardTable::getRace(int id) const
+{
+    if(id < 0 || id >= codes.count())   return INVALID_RACE;
+    return races[id];
+}
+
+
+QString CardTable::getSet(int id) const
+{
+    if(id < 0 || id >= codes.count())   return "";
+    return setNames[sets[id]];
+}
+
+
+bool CardTable::isCollectible(int id) const
+{
+    if(id < 0 || id >= codes.count())   return false;
+    return collectibles[id];
+}
+
+
+bool CardTable::isStandard(int id) const
+{
+    if(id < 0 || id >= codes.count())   return false;
+    return standards[id];
+}
+
+
+bool CardTable::isSecret(int id) const
+{
+    if(id < 0 || id >= codes.count())   return false;
+    return secrets[id];
+}
+
+
+QString CardTable::getEnName(int id) const
+{
+    if(id < 0 || id >= codes.count())   return "";
+    return enNames[id];
+}
+
+
+QString CardTable::getEnText(int id) const
+{
+    if(id < 0 || id >= codes.count())   return "";
+    return enTexts[id];
+}
+
+
+QString CardTable::getEnTextLower(int id) const
+{
+    if(id < 0 || id >= codes.count())   return "";
+    return enTextsLower[id];
+}
+
+
+QString CardTable::getLocalName(int id) const
+{
+    if(id < 0 || id >= localNames.count())  return "";
+    return localNames[id];
+}
+
+
+QString CardTable::getLocalText(int id) const
+{
+    if(id < 0 || id >= localTexts.count())  return "";
+    return localTexts[id];
+}
+
+
+//Mismo resultado que leer el atributo del json de la carta, Undefined si la carta no lo tiene.
+QJsonValue CardTable::getAttribute(int id, const QString &attribute) const
+{
+    if(id < 0 || id >= codes.count())   return QJsonValue(QJsonValue::Undefined);
+
+    int value = CARD_NO_VALUE;
+    if(attribute == "name")                 return getLocalName(id);
+    else if(attribute == "text")            return getLocalText(id);
+    else if(attribute == "set")             return setNames[sets[id]];
+    else if(attribute == "type")            return typeNames[typeNameIds[id]];
+    else if(attribute == "cardClass")       return classNames[classNameIds[id]];
+    else if(attribute == "collectible")     return collectibles[id];
+    else if(attribute == "mechanics")       return QJsonArray::fromStringList(mechanics[id]);
+    else if(attribute == "referencedTags")  return QJsonArray::fromStringList(referencedTags[id]);
+    else if(attribute == "cost")            value = costs[id];
+    else if(attribute == "attack")          value = attacks[id];
+    else if(attribute == "health")          value = healths[id];
+    else if(attribute == "dbfId")           value = dbfIds[id];
+    else if(attribute == "armor")           value = armors[id];
+    else if(attribute == "durability")      value = durabilities[id];
+    else if(attribute == "overload")        value = overloads[id];
+    else if(attribute == "spellDamage")     value = spellDamages[id];
+
+    if(value == CARD_NO_VALUE)  return QJsonValue(QJsonValue::Undefined);
+    else                        return value;
+}
+
+
+QVector<int> CardTable::getIdsFromEnName(const QString &name) const
+{
+    return enNameIds.value(name);
+}
+
+
+QVector<int> CardTable::getIdsFromLocalName(const QString &name) const
+{
+    return localNameIds.value(name);
+}
+
+
+int CardTable::getIdFromDbfId(int dbfId) const
+{
+    return dbfIdIds.value(dbfId, -1);
+}
+
+
+QStringList CardTable::idsToCodes(const QVector<int> &ids) const
+{
+    QStringList codeList;
+    codeList.reserve(ids.count());
+    for(int id: ids)    codeList.append(codes[id]);
+    return codeList;
+}
+
+
+QStringList CardTable::getSetCodes(const QString &set, bool onlyCollectible) const
+{
+    int index = setNames.indexOf(set);
+    if(index == -1) return QStringList();
+
+    if(!onlyCollectible)    return idsToCodes(setIds[index]);
+
+    QStringList codeList;
+    for(int id: setIds[index])
+    {
+        if(collectibles[id])    codeList.append(codes[id]);
+    }
+    return codeList;
+}
+
+
+QStringList CardTable::getCollectibleCodes() const
+{
+    return idsToCodes(collectibleIds);
+}
+
+
+QStringList CardTable::getStandardCodes() const
+{
+    return idsToCodes(standardIds);
+}
+
+
+CardType CardTable::typeFromString(const QString &value)
+{
+    if(value == "MINION")           return MINION;
+    else if(value == "SPELL")       return SPELL;
+    else if(value == "WEAPON")      return WEAPON;
+    else if(value == "ENCHANTMENT") return ENCHANTMENT;
+    else if(value == "HERO")        return HERO;
+    else if(value == "HERO_POWER")  return HERO_POWER;
+    else                            return INVALID_TYPE;
+}
+
+
+CardRarity CardTable::rarityFromString(const QString &value)
+{
+    if(value == "FREE")             return COMMON;
+    else if(value == "COMMON")      return COMMON;
+    else if(value == "RARE")        return RARE;
+    else if(value == "EPIC")        return EPIC;
+    else if(value == "LEGENDARY")   return LEGENDARY;
+    else                            return INVALID_RARITY;
+}
+
+
+CardClass CardTable::classFromString(const QString &value)
+{
+    if(value == "")             return NEUTRAL;
+    else if(value == "NEUTRAL") return NEUTRAL;
+    else if(value == "DRUID")   return DRUID;
+    else if(value == "HUNTER")  return HUNTER;
+    else if(value == "MAGE")    return MAGE;
+    else if(value == "PALADIN") return PALADIN;
+    else if(value == "PRIEST")  return PRIEST;
+    else if(value == "ROGUE")   return ROGUE;
+    else if(value == "SHAMAN")  return SHAMAN;
+    else if(value == "WARLOCK") return WARLOCK;
+    else if(value == "WARRIOR") return WARRIOR;
+    else if(value == "DREAM")   return DREAM;
+    else                        return INVALID_CLASS;
+}
+
+
+CardRace CardTable::raceFromString(const QString &value)
+{
+    if(value == "BLOODELF")         return BLOODELF;
+    else if(value == "DRAENEI")     return DRAENEI;
+    else if(value == "DWARF")       return DWARF;
+    else if(value == "GNOME")       return GNOME;
+    else if(value == "GOBLIN")      return GOBLIN;
+    else if(value == "HUMAN")       return HUMAN;
+    else if(value == "NIGHTELF")    return NIGHTELF;
+    else if(value == "ORC")         return ORC;
+    else if(value == "TAUREN")      return TAUREN;
+    else if(value == "TROLL")       return TROLL;
+    else if(value == "UNDEAD")      return UNDEAD;
+    else if(value == "WORGEN")      return WORGEN;
+    else if(value == "GOBLIN2")     return GOBLIN2;
+    else if(value == "MURLOC")      return MURLOC;
+    else if(value == "DEMON")       return DEMON;
+    else if(value == "SCOURGE")     return SCOURGE;
+    else if(value == "MECHANICAL")  return MECHANICAL;
+    else if(value == "ELEMENTAL")   return ELEMENTAL;
+    else if(value == "OGRE")        return OGRE;
+    else if(value == "BEAST")       return BEAST;
+    else if(value == "TOTEM")       return TOTEM;
+    else if(value == "NERUBIAN")    return NERUBIAN;
+    else if(value == "PIRATE")      return PIRATE;
+    else if(value == "DRAGON")      return DRAGON;
+    else                            return INVALID_RACE;
+}
+
+
+bool CardTable::isStandardSet(const QString &set)
+{
+    return  set == "CORE" || set == "EXPERT1" ||
+//            set == "HOF" || set == "NAXX" || set == "GVG" ||
+//            set == "BRM" || set == "TGT" || set == "LOE" ||
+//            set == "OG" || set == "KARA" || set == "GANGS" ||
+            set == "UNGORO" || set == "ICECROWN" || set == "LOOTAPALOOZA" ||
+            set == "GILNEAS" || set == "BOOMSDAY" || set == "TROLL";
+}
@@ -0,0 +1,108 @@
+#ifndef CARDTABLE_H
+#define CARDTABLE_H
+
+#include "../Cards/deckcard.h"
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QMap>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonValue>
+#include <QDataStream>
+#include <QFile>
+
+#define CARD_NO_VALUE -1
+#define CARDS_BIN_MAGIC 0x41544342
+#define CARDS_BIN_VERSION 2
+#define CARDS_BIN_STREAM_VERSION QDataStream::Qt_5_6
+
+
+//cards.json compilado en una tabla plana (una columna por atributo). Cada carta tiene un id entero,
+//su posicion en las columnas, y los atributos mas consultados ya convertidos a enums o pre-procesados.
+//Contiene todos los atributos que usa la app y se guarda tal cual en cards.bin.
+class CardTable
+{
+//Constructor
+public:
+    CardTable();
+
+//Variables
+private:
+    QHash<QString, int> codeIds;
+    QVector<QString> codes;
+    QVector<int> costs, attacks, healths;
+    QVector<int> dbfIds, armors, durabilities, overloads, spellDamages;
+    QVector<CardType> types;
+    QVector<CardRarity> rarities;
+    QVector<CardClass> classes;
+    QVector<CardRace> races;
+    QVector<quint16> sets;
+    QStringList setNames;
+    QVector<quint16> typeNameIds, classNameIds;
+    QStringList typeNames, classNames;
+    QVector<QStringList> mechanics, referencedTags;
+    QVector<bool> collectibles, standards, secrets;
+    QVector<QString> enNames, enTexts, enTextsLower;
+    QVector<QString> localNames, localTexts;
+
+    //Indices inversos, ids en orden de codigo (el mismo orden que recorrer cards.json por id).
+    QHash<QString, QVector<int>> enNameIds, localNameIds;
+    QHash<int, int> dbfIdIds;
+    QVector<QVector<int>> setIds;
+    QVector<int> collectibleIds, standardIds;
+
+//Metodos
+private:
+    static quint16 internString(QStringList &strings, const QString &value);
+    static int intOrNoValue(const QJsonValue &value);
+    static QStringList toStringList(const QJsonValue &value);
+    QStringList idsToCodes(const QVector<int> &ids) const;
+    void buildIndexes();
+    bool checkColumns(int numCards) const;
+    void buildLocalIndex();
+    static bool openSection(QFile &file, QDataStream &stream, const QString &section, int &numCards);
+
+public:
+    void build(const QJsonObject &cardsObject, const QString &localLang);
+    void buildLocal(const QJsonObject &cardsObject, const QString &localLang);
+    bool save(const QString &path, const QJsonObject &cardsObject) const;
+    bool load(const QString &path, const QString &localLang);
+    bool loadLocal(const QString &path, const QString &localLang);
+    int count() const;
+    int getId(const QString &code) const;
+    QString getCode(int id) const;
+    int getCost(int id) const;
+    int getAttack(int id) const;
+    int getHealth(int id) const;
+    CardType getType(int id) const;
+    CardRarity getRarity(int id) const;
+    CardClass getClass(int id) const;
+    CardRace getRace(int id) const;
+    QString getSet(int id) const;
+    bool isCollectible(int id) const;
+    bool isStandard(int id) const;
+    bool isSecret(int id) const;
+    QString getEnName(int id) const;
+    QString getEnText(int id) const;
+    QString getEnTextLower(int id) const;
+    QString getLocalName(int id) const;
+    QString getLocalText(int id) const;
+    QJsonValue getAttribute(int id, const QString &attribute) const;
+
+    QVector<int> getIdsFromEnName(const QString &name) const;
+    QVector<int> getIdsFromLocalName(const QString &name) const;
+    int getIdFromDbfId(int dbfId) const;
+    QStringList getSetCodes(const QString &set, bool onlyCollectible) const;
+    QStringList getCollectibleCodes() const;
+    QStringList getStandardCodes() const;
+
+    static CardType typeFromString(const QString &value);
+    static CardRarity rarityFromString(const QString &value);
+    static CardClass classFromString(const QString &value);
+    static CardRace raceFromString(const QString &value);
+    static bool isStandardSet(const QString &set);
+};
+
+#endif // CARDTABLE_H
@@ -0,0 +1,114 @@
+#include "histcache.h"
+#include <QtWidgets>
+
+
+HistCache::HistCache()
+{
+    modified = false;
+}
+
+
+void HistCache::load(const QString &filePath)
+{
+    this->filePath = filePath;
+    entries.clear();
+    modified = false;
+
+    QFile file(filePath);
+    if(!file.open(QIODevice::ReadOnly))     return;
+    QByteArray data = file.readAll();
+    file.close();
+
+    QDataStream stream(data);
+    stream.setVersion(HIST_CACHE_STREAM_VERSION);
+    quint32 magic, version;
+    qint32 numEntries;
+    stream >> magic >> version >> numEntries;
+    if(magic != HIST_CACHE_MAGIC || version != HIST_CACHE_VERSION ||
+        numEntries < 0 || numEntries > HIST_CACHE_MAX_ENTRIES)
+    {
+        qDebug()<<"HistCache: Ignoring" << filePath;
+        return;
+    }
+
+    entries.reserve(numEntries);
+    for(int i=0; i<numEntries; i++)
+    {
+        QString key;
+        HistCacheEntry entry;
+        qint32 rows, cols, type;
+        QByteArray histData;
+        stream >> key >> entry.mtime >> rows >> cols >> type >> histData;
+        if(stream.status() != QDataStream::Ok)
+        {
+            qDebug()<<"HistCache: Corrupted" << filePath;
+            entries.clear();
+            return;
+        }
+
+        if(rows != HIST_H_BINS || cols != HIST_S_BINS || type != CV_32F ||
+            histData.size() != static_cast<int>(HIST_H_BINS * HIST_S_BINS * sizeof(float)))   continue;
+        entry.hist.create(rows, cols, type);
+        memcpy(entry.hist.data, histData.constData(), static_cast<size_t>(histData.size()));
+        entries.insert(key, entry);
+    }
+}
+
+
+void HistCache::save()
+{
+    if(!modified || filePath.isEmpty())     return;
+
+    QSaveFile file(filePath);
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        qDebug()<<"HistCache: Cannot write" << filePath;
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(HIST_CACHE_STREAM_VERSION);
+    stream << static_cast<quint32>(HIST_CACHE_MAGIC) << static_cast<quint32>(HIST_CACHE_VERSION)
+           << static_cast<qint32>(entries.count());
+    for(QHash<QString, HistCacheEntry>::const_iterator it = entries.cbegin(); it != entries.cend(); it++)
+    {
+        const cv::MatND hist = it->hist.isContinuous()?it->hist:it->hist.clone();
+        stream << it.key() << it->mtime << static_cast<qint32>(hist.rows) << static_cast<qint32>(hist.cols)
+               << static_cast<qint32>(hist.type())
+               << QByteArray(reinterpret_cast<const char *>(hist.data), static_cast<int>(hist.total() * hist.elemSize()));
+    }
+
+    if(stream.status() != QDataStream::Ok)  file.cancelWriting();
+    if(!file.commit())
+    {
+        qDebug()<<"HistCache: Cannot write" << filePath;
+        return;
+    }
+    modified = false;
+}
+
+
+void HistCache::clear()
+{
+    entries.clear();
+    modified = false;
+}
+
+
+bool HistCache::find(const QString &key, qint64 mtime, cv::MatND &hist) const
+{
+    QHash<QString, HistCacheEntry>::const_iterator it = entries.constFind(key);
+    if(it == entries.cend() || it->mtime != mtime)  return false;
+    hist = it->hist;
+    return true;
+}
+
+
+void HistCache::insert(const QString &key, qint64 mtime, const cv::MatND &hist)
+{
+    HistCacheEntry entry;
+    entry.mtime = mtime;
+    entry.hist = hist;
+    entries.insert(key, entry);
+    modified = true;
+}
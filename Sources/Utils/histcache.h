@@ -0,0 +1,48 @@
+#ifndef HISTCACHE_H
+#define HISTCACHE_H
+
+#include "opencv2/opencv.hpp"
+#include <QString>
+#include <QHash>
+
+#define HIST_CACHE_MAGIC    0x41544843
+#define HIST_CACHE_VERSION  2
+#define HIST_CACHE_STREAM_VERSION   QDataStream::Qt_5_6
+#define HIST_CACHE_MAX_ENTRIES      100000
+//Bins de hue y saturacion de los histogramas de DraftHandler::getHist.
+#define HIST_H_BINS 50
+#define HIST_S_BINS 60
+
+
+class HistCacheEntry
+{
+public:
+    qint64 mtime;
+    cv::MatND hist;
+};
+
+
+//Histogramas de las imagenes de cartas guardados en disco, clave = code(_premium) + fecha de modificacion del png.
+//Se lee entero de una vez al empezar el draft y solo se reescribe si hay histogramas nuevos.
+class HistCache
+{
+//Constructor
+public:
+    HistCache();
+
+//Variables
+private:
+    QString filePath;
+    QHash<QString, HistCacheEntry> entries;
+    bool modified;
+
+//Metodos
+public:
+    void load(const QString &filePath);
+    void save();
+    void clear();
+    bool find(const QString &key, qint64 mtime, cv::MatND &hist) const;
+    void insert(const QString &key, qint64 mtime, const cv::MatND &hist);
+};
+
+#endif // HISTCACHE_H
@@ -0,0 +1,177 @@
+#include "histmatcher.h"
+#include <QtWidgets>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+
+HistMatcher::HistMatcher()
+{
+
+}
+
+
+//groups: code --> grupo (0..n-1), los codes que no aparecen van al grupo 0.
+void HistMatcher::build(const QMap<QString, cv::MatND> &hists, const QHash<QString, int> &groups)
+{
+    clear();
+
+    int bins = 0;
+    for(QMap<QString, cv::MatND>::const_iterator it = hists.cbegin(); it != hists.cend(); it++)
+    {
+        if(it->empty())     continue;
+        if(bins == 0)       bins = static_cast<int>(it->total());
+        if(static_cast<int>(it->total()) != bins)
+        {
+            qDebug()<<"HistMatcher: Ignoring hist with wrong size" << it.key();
+            continue;
+        }
+        codes.append(it.key());
+    }
+    if(codes.isEmpty())     return;
+
+    //Ordenamos por grupo, manteniendo el orden de codigo dentro de cada grupo
+    std::stable_sort(codes.begin(), codes.end(), [&groups](const QString &a, const QString &b)
+    {
+        return groups.value(a, 0) < groups.value(b, 0);
+    });
+    int numGroups = 1;
+    for(const QString &code: codes)     numGroups = std::max(numGroups, groups.value(code, 0) + 1);
+    groupStarts.fill(0, numGroups + 1);
+    for(const QString &code: codes)     groupStarts[groups.value(code, 0) + 1]++;
+    for(int g=1; g<=numGroups; g++)     groupStarts[g] += groupStarts[g-1];
+
+    sqrtHists.create(codes.count(), bins, CV_32F);
+    histSums.create(codes.count(), 1, CV_32F);
+    codeIndexes.reserve(codes.count());
+
+    for(int i=0; i<codes.count(); i++)
+    {
+        const cv::MatND &hist = hists[codes[i]];
+        cv::Mat histRow;
+        hist.reshape(1, 1).convertTo(histRow, CV_32F);
+        histSums.at<float>(i) = static_cast<float>(cv::sum(histRow)[0]);
+        cv::Mat sqrtRow = sqrtHists.row(i);
+        cv::sqrt(histRow, sqrtRow);
+        codeIndexes.insert(codes[i], i);
+    }
+}
+
+
+void HistMatcher::clear()
+{
+    codes.clear();
+    codeIndexes.clear();
+    sqrtHists.release();
+    histSums.release();
+    groupStarts.clear();
+}
+
+
+bool HistMatcher::isEmpty() const
+{
+    return codes.isEmpty();
+}
+
+
+int HistMatcher::count() const
+{
+    return codes.count();
+}
+
+
+QString HistMatcher::getCode(int index) const
+{
+    if(index < 0 || index >= codes.count()) return "";
+    return codes[index];
+}
+
+
+int HistMatcher::getIndex(const QString &code) const
+{
+    return codeIndexes.value(code, -1);
+}
+
+
+int HistMatcher::groupCount() const
+{
+    return std::max(0, groupStarts.count() - 1);
+}
+
+
+int HistMatcher::groupBegin(int group) const
+{
+    if(groupStarts.isEmpty())   return 0;
+    return groupStarts[std::max(0, std::min(group, groupCount()))];
+}
+
+
+int HistMatcher::groupEnd(int group) const
+{
+    if(groupStarts.isEmpty())   return 0;
+    return groupStarts[std::max(0, std::min(group + 1, groupCount()))];
+}
+
+
+//distances[i][j] = Bhattacharyya(hists[i], carta j), igual que compareHist(hists[i], hist j, 3).
+//Solo se calculan las columnas [beginRow, endRow) (endRow -1 = hasta el final), el resto valen 1 (maxima distancia).
+void HistMatcher::match(const cv::MatND hists[], int numHists, cv::Mat &distances, int beginRow, int endRow) const
+{
+    if(isEmpty() || numHists <= 0)
+    {
+        distances.release();
+        return;
+    }
+
+    if(endRow < 0 || endRow > codes.count())    endRow = codes.count();
+    if(beginRow < 0 || beginRow >= endRow)
+    {
+        beginRow = 0;
+        endRow = codes.count();
+    }
+
+    cv::Mat sqrtQueries(numHists, sqrtHists.cols, CV_32F);
+    QVector<float> querySums(numHists);
+    for(int i=0; i<numHists; i++)
+    {
+        cv::Mat histRow;
+        hists[i].reshape(1, 1).convertTo(histRow, CV_32F);
+        querySums[i] = static_cast<float>(cv::sum(histRow)[0]);
+        cv::Mat sqrtRow = sqrtQueries.row(i);
+        cv::sqrt(histRow, sqrtRow);
+    }
+
+    //numHists x numCodes, sum(sqrt(h1*h2)) de cada par
+    distances.create(numHists, codes.count(), CV_32F);
+    if(beginRow > 0 || endRow < codes.count())  distances.setTo(1);
+    cv::Mat rangeDistances = distances.colRange(beginRow, endRow);
+    cv::gemm(sqrtQueries, sqrtHists.rowRange(beginRow, endRow), 1, cv::noArray(), 0, rangeDistances, cv::GEMM_2_T);
+
+    for(int i=0; i<numHists; i++)
+    {
+        float *row = distances.ptr<float>(i);
+        for(int j=beginRow; j<endRow; j++)
+        {
+            float norm = querySums[i] * histSums.at<float>(j);
+            float scale = (norm > FLT_EPSILON)?(1.f / std::sqrt(norm)):1.f;
+            row[j] = std::sqrt(std::max(1.f - row[j] * scale, 0.f));
+        }
+    }
+}
+
+
+//Indices de los k menores valores de la fila, ordenados de menor a mayor.
+QVector<int> HistMatcher::topK(const cv::Mat &distances, int row, int k)
+{
+    QVector<int> indexes(distances.cols);
+    for(int j=0; j<indexes.count(); j++)    indexes[j] = j;
+    k = std::min(k, indexes.count());
+
+    const float *values = distances.ptr<float>(row);
+    std::partial_sort(indexes.begin(), indexes.begin() + k, indexes.end(), [values](int a, int b)
+    {
+        return (values[a] < values[b]) || (values[a] == values[b] && a < b);
+    });
+    indexes.resize(k);
+    return indexes;
+}
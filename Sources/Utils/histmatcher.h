@@ -0,0 +1,44 @@
+#ifndef HISTMATCHER_H
+#define HISTMATCHER_H
+
+#include "opencv2/opencv.hpp"
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QMap>
+#include <QVector>
+
+
+//Histogramas de cartas empaquetados en una matriz (una fila por carta, sqrt ya aplicado) para calcular
+//la distancia Bhattacharyya (compareHist metodo 3) contra todas las cartas con un solo producto de matrices.
+//Las filas pueden agruparse (p.ej. por rareza) para comparar solo contra un rango contiguo de grupos.
+class HistMatcher
+{
+//Constructor
+public:
+    HistMatcher();
+
+//Variables
+private:
+    QStringList codes;
+    QHash<QString, int> codeIndexes;
+    cv::Mat sqrtHists;  //CV_32F, codes.count() x bins
+    cv::Mat histSums;   //CV_32F, codes.count() x 1
+    QVector<int> groupStarts;   //Grupo g = filas [groupStarts[g], groupStarts[g+1])
+
+//Metodos
+public:
+    void build(const QMap<QString, cv::MatND> &hists, const QHash<QString, int> &groups = QHash<QString, int>());
+    void clear();
+    bool isEmpty() const;
+    int count() const;
+    QString getCode(int index) const;
+    int getIndex(const QString &code) const;
+    int groupCount() const;
+    int groupBegin(int group) const;
+    int groupEnd(int group) const;
+    void match(const cv::MatND hists[], int numHists, cv::Mat &distances, int beginRow=0, int endRow=-1) const;
+    static QVector<int> topK(const cv::Mat &distances, int row, int k);
+};
+
+#endif // HISTMATCHER_H
@@ -0,0 +1,152 @@
+#include "screenlocator.h"
+#include "../utility.h"
+#include <QtWidgets>
+
+
+ScreenLocator::ScreenLocator()
+{
+
+}
+
+
+void ScreenLocator::clear()
+{
+    QMutexLocker locker(&mutex);
+    templates.clear();
+    homographies.clear();
+}
+
+
+//Devuelve una copia (las cv::Mat se comparten) para no depender del mapa fuera del mutex.
+bool ScreenLocator::getTemplateFeatures(const QString &templateImage, TemplateFeatures &features)
+{
+    QMutexLocker locker(&mutex);
+    if(templates.contains(templateImage))
+    {
+        features = templates[templateImage];
+        return true;
+    }
+
+    cv::Mat img_object = cv::imread((Utility::extraPath() + "/" + templateImage).toStdString(), CV_LOAD_IMAGE_GRAYSCALE);
+    if(!img_object.data)
+    {
+        qDebug() << "ScreenLocator: Cannot find" << templateImage;
+        return false;
+    }
+
+    features.scale = std::min(1.0, LOCATOR_TEMPLATE_HEIGHT / static_cast<double>(img_object.rows));
+    cv::resize(img_object, features.image, cv::Size(), features.scale, features.scale, cv::INTER_AREA);
+
+    cv::ORB orb(LOCATOR_ORB_FEATURES);
+    orb(features.image, cv::noArray(), features.keypoints, features.descriptors);
+    qDebug() << "ScreenLocator: Template" << templateImage << "keypoints:" << features.keypoints.size();
+
+    templates[templateImage] = features;
+    return true;
+}
+
+
+//Homografia template -> scene (ambos a escala de trabajo), vacia si no hay suficientes matches.
+cv::Mat ScreenLocator::findHomography(const TemplateFeatures &features, const cv::Mat &scene)
+{
+    std::vector<cv::KeyPoint> keypoints_scene;
+    cv::Mat descriptors_scene;
+    cv::ORB orb(LOCATOR_ORB_FEATURES);
+    orb(scene, cv::noArray(), keypoints_scene, descriptors_scene);
+    if(descriptors_scene.rows < 2 || features.descriptors.empty())  return cv::Mat();
+
+    cv::BFMatcher matcher(cv::NORM_HAMMING);
+    std::vector<std::vector<cv::DMatch>> matches;
+    matcher.knnMatch(features.descriptors, descriptors_scene, matches, 2);
+
+    //Ratio test de Lowe
+    std::vector<cv::Point2f> obj, sceneFound;
+    for(const std::vector<cv::DMatch> &match: matches)
+    {
+        if(match.size() < 2)    continue;
+        if(match[0].distance < LOCATOR_RATIO_TEST * match[1].distance)
+        {
+            obj.push_back(features.keypoints[static_cast<ulong>(match[0].queryIdx)].pt);
+            sceneFound.push_back(keypoints_scene[static_cast<ulong>(match[0].trainIdx)].pt);
+        }
+    }
+    qDebug() << "ScreenLocator: ORB Keypoints buenos:" << obj.size();
+    if(obj.size() < LOCATOR_MIN_MATCHES)    return cv::Mat();
+
+    std::vector<uchar> inliers;
+    cv::Mat H = cv::findHomography(obj, sceneFound, CV_RANSAC, 3, inliers);
+    if(H.empty() || cv::countNonZero(inliers) < LOCATOR_MIN_MATCHES)    return cv::Mat();
+    return H;
+}
+
+
+//Deshace la perspectiva de la pantalla al marco del template y compara ambas imagenes.
+bool ScreenLocator::verifyHomography(const cv::Mat &H, const TemplateFeatures &features, const cv::Mat &scene)
+{
+    cv::Mat warped, result;
+    cv::warpPerspective(scene, warped, H, features.image.size(), cv::INTER_LINEAR | cv::WARP_INVERSE_MAP);
+    cv::matchTemplate(warped, features.image, result, CV_TM_CCOEFF_NORMED);
+    double correlation = static_cast<double>(result.at<float>(0, 0));
+    return correlation > LOCATOR_VERIFY_THRESHOLD;
+}
+
+
+std::vector<cv::Point2f> ScreenLocator::findTemplateOnScreen(const QString &templateImage, QScreen *screen,
+                                                             const std::vector<cv::Point2f> &templatePoints, QPointF &screenScale)
+{
+    QRect rect = screen->geometry();
+    QImage image = screen->grabWindow(0,rect.x(),rect.y(),rect.width(),rect.height()).toImage();
+    if(image.isNull())  return std::vector<cv::Point2f>();
+
+    //Screen scale
+    screenScale.setX(rect.width() / static_cast<qreal>(image.width()));
+    screenScale.setY(rect.height() / static_cast<qreal>(image.height()));
+
+    //El QImage sigue vivo mientras usamos mat
+    cv::Mat mat(image.height(),image.width(),CV_8UC4,image.bits(), static_cast<size_t>(image.bytesPerLine()));
+    return findTemplateOnImage(templateImage, mat, screen->name(), templatePoints);
+}
+
+
+//image BGR o BGRA. imageKey identifica el origen de la imagen (pantalla) para cachear su homografia.
+std::vector<cv::Point2f> ScreenLocator::findTemplateOnImage(const QString &templateImage, const cv::Mat &image, const QString &imageKey,
+                                                            const std::vector<cv::Point2f> &templatePoints)
+{
+    std::vector<cv::Point2f> screenPoints;
+    TemplateFeatures features;
+    if(!getTemplateFeatures(templateImage, features))   return screenPoints;
+
+    //Busqueda gruesa en la imagen reducida
+    double sceneScale = std::min(1.0, LOCATOR_SCENE_HEIGHT / static_cast<double>(image.rows));
+    cv::Mat img_scene, img_small;
+    cv::resize(image, img_small, cv::Size(), sceneScale, sceneScale, cv::INTER_AREA);
+    cv::cvtColor(img_small, img_scene, CV_BGR2GRAY);
+
+    //Homografia cacheada para esta pantalla y resolucion
+    const QString key = templateImage + "/" + imageKey + "/" +
+            QString::number(image.cols) + "x" + QString::number(image.rows);
+    mutex.lock();
+    cv::Mat H = homographies.value(key);
+    mutex.unlock();
+    if(!H.empty() && !verifyHomography(H, features, img_scene))
+    {
+        qDebug() << "ScreenLocator: Cached homography rejected" << key;
+        H = cv::Mat();
+    }
+
+    if(H.empty())
+    {
+        H = findHomography(features, img_scene);
+        if(H.empty())   return screenPoints;
+        QMutexLocker locker(&mutex);
+        homographies[key] = H;
+    }
+
+    //templatePoints estan en coordenadas del template original y screenPoints en pixeles de la pantalla
+    std::vector<cv::Point2f> workPoints;
+    for(const cv::Point2f &point: templatePoints)   workPoints.push_back(point * static_cast<float>(features.scale));
+    cv::perspectiveTransform(workPoints, screenPoints, H);
+    for(cv::Point2f &point: screenPoints)           point *= static_cast<float>(1/sceneScale);
+
+    return screenPoints;
+}
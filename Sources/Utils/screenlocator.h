@@ -0,0 +1,60 @@
+#ifndef SCREENLOCATOR_H
+#define SCREENLOCATOR_H
+
+#include "opencv2/opencv.hpp"
+#include <QString>
+#include <QMap>
+#include <QPointF>
+#include <QScreen>
+#include <QMutex>
+
+#define LOCATOR_TEMPLATE_HEIGHT     512     //Altura de trabajo del template
+#define LOCATOR_SCENE_HEIGHT        720     //Altura maxima de trabajo de la pantalla (busqueda gruesa)
+#define LOCATOR_ORB_FEATURES        1500
+#define LOCATOR_RATIO_TEST          0.75
+#define LOCATOR_MIN_MATCHES         10
+#define LOCATOR_VERIFY_THRESHOLD    0.5     //Correlacion minima para dar por buena una homografia cacheada
+
+
+class TemplateFeatures
+{
+public:
+    cv::Mat image;      //Gris, a LOCATOR_TEMPLATE_HEIGHT
+    double scale = 1;   //image / template original
+    std::vector<cv::KeyPoint> keypoints;
+    cv::Mat descriptors;
+};
+
+
+//Localiza un template (arenaTemplate.png, heroesTemplate.png) en una pantalla.
+//Los keypoints/descriptores ORB del template se calculan una sola vez y la ultima homografia encontrada
+//se guarda por template/pantalla/resolucion, de forma que volver a la pantalla de arena solo requiere
+//una verificacion por correlacion en lugar de una deteccion completa.
+//Puede usarse desde varios threads a la vez (una pantalla por thread).
+class ScreenLocator
+{
+//Constructor
+public:
+    ScreenLocator();
+
+//Variables
+private:
+    QMap<QString, TemplateFeatures> templates;
+    QMap<QString, cv::Mat> homographies;    //Homografia template(trabajo) -> pantalla(trabajo)
+    QMutex mutex;
+
+//Metodos
+private:
+    bool getTemplateFeatures(const QString &templateImage, TemplateFeatures &features);
+    static cv::Mat findHomography(const TemplateFeatures &features, const cv::Mat &scene);
+    static bool verifyHomography(const cv::Mat &H, const TemplateFeatures &features, const cv::Mat &scene);
+
+public:
+    std::vector<cv::Point2f> findTemplateOnScreen(const QString &templateImage, QScreen *screen,
+                                                  const std::vector<cv::Point2f> &templatePoints, QPointF &screenScale);
+    std::vector<cv::Point2f> findTemplateOnImage(const QString &templateImage, const cv::Mat &image, const QString &imageKey,
+                                                 const std::vector<cv::Point2f> &templatePoints);
+    void clear();
+};
+
+#endif // SCREENLOCATOR_H
@@ -61,6 +61,12 @@ void ArrowGraphicsItem::increaseNumAttacks()
 }
 
 
+int ArrowGraphicsItem::getNumAttacks()
+{
+    return this->numAttacks;
+}
+
+
 QRectF ArrowGraphicsItem::boundingRect() const
 {
     QPointF from = this->from->pos();
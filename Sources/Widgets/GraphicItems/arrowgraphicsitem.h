@@ -33,6 +33,7 @@ public:
     void setEnd(bool isFrom, MinionGraphicsItem *item);
     void prepareGeometryChange();
     void increaseNumAttacks();
+    int getNumAttacks();
     MinionGraphicsItem *getEnd(bool isFrom);
     ArrowType getArrowType();
 };
@@ -22,6 +22,7 @@ CardGraphicsItem::CardGraphicsItem( int id, QString code, QString createdByCode,
     this->graphicsItemSender = graphicsItemSender;
     friendly?this->setZValue(-10):this->setZValue(-30);
     setAcceptHoverEvents(true);
+    setCacheMode(QGraphicsItem::DeviceCoordinateCache);
 }
 
 
@@ -49,6 +50,29 @@ CardGraphicsItem::CardGraphicsItem(CardGraphicsItem *copy)
     this->setPos(copy->pos());
     this->setZValue(copy->zValue());
     setAcceptHoverEvents(true);
+    setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+}
+
+
+CardGraphicsItem::CardGraphicsItem(QDataStream &stream, GraphicsItemSender *graphicsItemSender)
+{
+    QPointF pos;
+    qreal zValue;
+    stream >> code >> createdByCode >> id >> cost >> origCost >> attack >> origAttack >> health >> origHealth
+           >> buffAttack >> buffHealth >> played >> discard >> draw >> heightShow >> turn >> friendly >> pos >> zValue;
+    this->showTransparent = false;
+    this->graphicsItemSender = graphicsItemSender;
+    this->setPos(pos);
+    this->setZValue(zValue);
+    setAcceptHoverEvents(true);
+    setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+}
+
+
+void CardGraphicsItem::saveState(QDataStream &stream)
+{
+    stream << code << createdByCode << id << cost << origCost << attack << origAttack << health << origHealth
+           << buffAttack << buffHealth << played << discard << draw << heightShow << turn << friendly << pos() << zValue();
 }
 
 
@@ -209,7 +233,12 @@ void CardGraphicsItem::setZonePos(bool friendly, int pos, int cardsZone, int vie
     if(cardHeightShow > HEIGHT)     cardHeightShow = HEIGHT;
     const int hMinion = MinionGraphicsItem::HEIGHT-5;
     const int hHero = HeroGraphicsItem::HEIGHT;
-    this->heightShow = cardHeightShow;
+    if(this->heightShow != cardHeightShow)
+    {
+        prepareGeometryChange();
+        this->heightShow = cardHeightShow;
+        update();
+    }
     viewWidth -= WIDTH+8 - viewWidth/cardsZone;
     const int wCard = std::min(175, viewWidth/cardsZone);
     int x = static_cast<int>(wCard*(pos - (cardsZone-1)/2.0));
@@ -252,7 +281,7 @@ void CardGraphicsItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *
     if(!code.isEmpty())
     {
         painter->drawPixmap(-WIDTH/2, -heightShow/2+(cardLifted?-CARD_LIFT:0),
-                            QPixmap(Utility::hscardsPath() + "/" + code + ".png"), 5, 34, WIDTH,
+                            Utility::getCardPixmap(code), 5, 34, WIDTH,
                             heightShow+(cardLifted?CARD_LIFT:0));
 
         if(cost != origCost)
@@ -335,7 +364,7 @@ void CardGraphicsItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *
     else if(!createdByCode.isEmpty())
     {
         painter->drawPixmap(-48, -heightShow/2+24+(cardLifted?-CARD_LIFT:0),
-                            QPixmap(Utility::hscardsPath() + "/" + createdByCode + ".png"), 49, 60, 101, 66);
+                            Utility::getCardPixmap(createdByCode), 49, 60, 101, 66);
         painter->drawPixmap(-81, -heightShow/2+15+(cardLifted?-CARD_LIFT:0),
                             QPixmap(":/Images/bgCardCreatedBy.png"), 0, 0, 168,
                             heightShow-15+(cardLifted?CARD_LIFT:0));
@@ -2,6 +2,7 @@
 #define CARDGRAPHICSITEM_H
 
 #include <QGraphicsItem>
+#include <QDataStream>
 #include "graphicsitemsender.h"
 #include "miniongraphicsitem.h"
 
@@ -16,6 +17,7 @@ friend class MinionGraphicsItem;
 public:
     CardGraphicsItem(int id, QString code, QString createdByCode, int turn, bool friendly, GraphicsItemSender *graphicsItemSender);
     CardGraphicsItem(CardGraphicsItem *copy);
+    CardGraphicsItem(QDataStream &stream, GraphicsItemSender *graphicsItemSender);
 
 //Variables
 private:
@@ -64,6 +66,7 @@ public:
     void setShowTransparent(bool value=true);
     bool isTransparent();
     void changeCode(QString newCode);
+    void saveState(QDataStream &stream);
 };
 
 #endif // CARDGRAPHICSITEM_H
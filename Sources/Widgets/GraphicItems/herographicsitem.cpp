@@ -51,6 +51,40 @@ HeroGraphicsItem::HeroGraphicsItem(HeroGraphicsItem *copy, bool copySecretCodes)
 }
 
 
+HeroGraphicsItem::HeroGraphicsItem(QDataStream &stream, GraphicsItemSender *graphicsItemSender)
+    :MinionGraphicsItem(stream, graphicsItemSender)
+{
+    qint32 numSecrets;
+    stream >> heroCode >> armor >> minionsAttack >> minionsMaxAttack >> resources >> resourcesUsed >> spellDamage
+           >> numSecrets;
+    this->showAllInfo = false;
+    this->heroWeapon = nullptr; //Se asigna al recuperar el weapon del board, igual que en copyBoard
+
+    for(int i=0; i<numSecrets; i++)
+    {
+        SecretIcon secretIcon;
+        qint32 secretHero;
+        stream >> secretIcon.id >> secretIcon.code >> secretHero;
+        secretIcon.secretHero = static_cast<CardClass>(secretHero);
+        this->secretsList.append(secretIcon);
+    }
+}
+
+
+//saveSecretCodes = false equivale a copySecretCodes = false en el constructor copia.
+void HeroGraphicsItem::saveState(QDataStream &stream, bool saveSecretCodes, bool asCopy)
+{
+    MinionGraphicsItem::saveState(stream, asCopy);
+    stream << heroCode << armor << minionsAttack << minionsMaxAttack << resources << resourcesUsed << spellDamage
+           << static_cast<qint32>(secretsList.count());
+
+    foreach(SecretIcon secretIcon, secretsList)
+    {
+        stream << secretIcon.id << (saveSecretCodes?secretIcon.code:QString()) << static_cast<qint32>(secretIcon.secretHero);
+    }
+}
+
+
 void HeroGraphicsItem::changeHero(QString code, int id)
 {
     this->code = code;
@@ -82,6 +116,7 @@ void HeroGraphicsItem::checkDownloadedCode(QString code)
 void HeroGraphicsItem::setShowAllInfo(bool value)
 {
     this->showAllInfo = value;
+    update();
 }
 
 
@@ -396,12 +431,11 @@ void HeroGraphicsItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *
 {
     Q_UNUSED(option);
 
-    QString heroCodePath = Utility::hscardsPath() + "/" + heroCode + ".png";
-    if(QFileInfo(heroCodePath).exists())
+    QPixmap pixmap = Utility::getCardPixmap(heroCode);
+    if(!pixmap.isNull())
     {
         QRectF target = QRectF( -80, -92, 160, 184);
         QRectF source(34, 112, 240, 276);
-        QPixmap pixmap(heroCodePath);
         painter->drawPixmap(target, pixmap, source);
     }
 
@@ -519,7 +553,7 @@ void HeroGraphicsItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *
         QString secretCode = secretsList[i].code;
         if(!secretCode.isEmpty())
         {
-            painter->setBrush(QBrush(QPixmap(Utility::hscardsPath() + "/" + secretCode + ".png")));
+            painter->setBrush(QBrush(Utility::getCardPixmap(secretCode)));
             painter->setBrushOrigin(QPointF(100+moveX,202+moveY));
             painter->drawEllipse(QPointF(moveX,moveY), 16, 16);
         }
@@ -556,7 +590,7 @@ void HeroGraphicsItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *
         }
         else
         {
-            painter->setBrush(QBrush(QPixmap(Utility::hscardsPath() + "/" + addonCode + ".png")));
+            painter->setBrush(QBrush(Utility::getCardPixmap(addonCode)));
             painter->setBrushOrigin(QPointF(100+moveX,202+moveY));
             painter->drawEllipse(QPointF(moveX,moveY), 32, 32);
         }
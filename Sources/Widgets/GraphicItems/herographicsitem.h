@@ -20,6 +20,7 @@ class HeroGraphicsItem : public MinionGraphicsItem
 public:
     HeroGraphicsItem(QString code, int id, bool friendly, bool playerTurn, GraphicsItemSender *graphicsItemSender);
     HeroGraphicsItem(HeroGraphicsItem *copy, bool copySecretCodes=false);
+    HeroGraphicsItem(QDataStream &stream, GraphicsItemSender *graphicsItemSender);
 
 //Variables:
 private:
@@ -69,6 +70,7 @@ public:
     int getAvailableResources();
     void damagePlanningMinion(int damage=1);
     void checkDownloadedCode(QString code);
+    void saveState(QDataStream &stream, bool saveSecretCodes=true, bool asCopy=false);
 };
 
 #endif // HEROGRAPHICSITEM_H
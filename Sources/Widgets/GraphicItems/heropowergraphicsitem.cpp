@@ -20,6 +20,7 @@ HeroPowerGraphicsItem::HeroPowerGraphicsItem(QString code, int id, bool friendly
     this->showTransparent = false;
     this->setPos(x, y);
     this->setZValue(-40);
+    setCacheMode(QGraphicsItem::DeviceCoordinateCache);
 }
 
 
@@ -34,6 +35,26 @@ HeroPowerGraphicsItem::HeroPowerGraphicsItem(HeroPowerGraphicsItem *copy)
     this->playerTurn = copy->playerTurn;
     this->setPos(copy->pos());
     this->setZValue(copy->zValue());
+    setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+}
+
+
+HeroPowerGraphicsItem::HeroPowerGraphicsItem(QDataStream &stream, GraphicsItemSender *graphicsItemSender)
+{
+    QPointF pos;
+    qreal zValue;
+    stream >> code >> id >> exausted >> friendly >> playerTurn >> pos >> zValue;
+    this->showTransparent = false;
+    this->graphicsItemSender = graphicsItemSender;
+    this->setPos(pos);
+    this->setZValue(zValue);
+    setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+}
+
+
+void HeroPowerGraphicsItem::saveState(QDataStream &stream)
+{
+    stream << code << id << exausted << friendly << playerTurn << pos() << zValue();
 }
 
 
@@ -143,7 +164,7 @@ void HeroPowerGraphicsItem::paint(QPainter *painter, const QStyleOptionGraphicsI
     if(playerTurn == friendly)
     {
         //Card background
-        painter->setBrush(QBrush(QPixmap(Utility::hscardsPath() + "/" + this->code + ".png")));
+        painter->setBrush(QBrush(Utility::getCardPixmap(this->code)));
         painter->setBrushOrigin(QPointF(101,210));//99+2,204+6
         painter->drawEllipse(QPointF(2,6), 40, 40);
 
@@ -2,6 +2,7 @@
 #define HEROPOWERGRAPHICSITEM_H
 
 #include <QGraphicsItem>
+#include <QDataStream>
 #include "graphicsitemsender.h"
 
 class HeroPowerGraphicsItem : public QGraphicsItem
@@ -10,6 +11,7 @@ public:
 //Constructor
     HeroPowerGraphicsItem(QString code, int id, bool friendly, bool playerTurn, GraphicsItemSender *graphicsItemSender);
     HeroPowerGraphicsItem(HeroPowerGraphicsItem *copy);
+    HeroPowerGraphicsItem(QDataStream &stream, GraphicsItemSender *graphicsItemSender);
 
 //Variables
 private:
@@ -42,6 +44,7 @@ public:
     void showManaPlayable(int mana);
     void setShowTransparent(bool value=true);
     bool isTransparent();
+    void saveState(QDataStream &stream);
 };
 
 #endif // HEROPOWERGRAPHICSITEM_H
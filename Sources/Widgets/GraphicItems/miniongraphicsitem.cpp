@@ -14,6 +14,7 @@ MinionGraphicsItem::MinionGraphicsItem(QString code, int id, bool friendly, bool
     this->graphicsItemSender = graphicsItemSender;
     this->setZValue(-50);
     setAcceptHoverEvents(true);
+    setCacheMode(QGraphicsItem::DeviceCoordinateCache);
 }
 
 
@@ -49,6 +50,7 @@ MinionGraphicsItem::MinionGraphicsItem(MinionGraphicsItem *copy, bool triggerMin
     this->setPos(copy->pos());
     this->setZValue(copy->zValue());
     setAcceptHoverEvents(true);
+    setCacheMode(QGraphicsItem::DeviceCoordinateCache);
 
     foreach(Addon addon, copy->addons)
     {
@@ -57,6 +59,52 @@ MinionGraphicsItem::MinionGraphicsItem(MinionGraphicsItem *copy, bool triggerMin
 }
 
 
+//Recupera un minion guardado con saveState (board compacto de PlanHandler).
+MinionGraphicsItem::MinionGraphicsItem(QDataStream &stream, GraphicsItemSender *graphicsItemSender)
+{
+    qint32 changeAttack, changeHealth, numAddons;
+    QPointF pos;
+    qreal zValue;
+    stream >> code >> id >> friendly >> hero >> attack >> origAttack >> health >> origHealth >> damage
+           >> shield >> taunt >> stealth >> frozen >> windfury >> charge >> exausted >> dead >> toBeDestroyed
+           >> playerTurn >> addonsStacked >> triggerMinion >> aura >> zone >> changeAttack >> changeHealth
+           >> pos >> zValue >> numAddons;
+    this->changeAttack = static_cast<ValueChange>(changeAttack);
+    this->changeHealth = static_cast<ValueChange>(changeHealth);
+    this->deadProb = 0;
+    this->graphicsItemSender = graphicsItemSender;
+    this->setPos(pos);
+    this->setZValue(zValue);
+    setAcceptHoverEvents(true);
+    setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+
+    for(int i=0; i<numAddons; i++)
+    {
+        Addon addon;
+        qint32 type;
+        stream >> addon.code >> addon.id >> addon.number >> type;
+        addon.type = static_cast<Addon::AddonType>(type);
+        this->addons.append(addon);
+    }
+}
+
+
+//asCopy guarda el minion como lo dejaria el constructor de copia (zone PLAY, sin triggerMinion), ver PlanHandler::compactBoardCopy.
+void MinionGraphicsItem::saveState(QDataStream &stream, bool asCopy)
+{
+    stream << code << id << friendly << hero << attack << origAttack << health << origHealth << damage
+           << shield << taunt << stealth << frozen << windfury << charge << exausted << dead << toBeDestroyed
+           << playerTurn << addonsStacked << (asCopy?false:triggerMinion) << aura << (asCopy?QString("PLAY"):zone)
+           << static_cast<qint32>(changeAttack) << static_cast<qint32>(changeHealth)
+           << pos() << zValue() << static_cast<qint32>(addons.count());
+
+    foreach(Addon addon, addons)
+    {
+        stream << addon.code << addon.id << addon.number << static_cast<qint32>(addon.type);
+    }
+}
+
+
 void MinionGraphicsItem::changeCode(QString newCode)
 {
     initCode(newCode);
@@ -472,6 +520,7 @@ void MinionGraphicsItem::changeZone()
 {
     this->friendly = !this->friendly;
     this->exausted = !this->charge;
+    update();
 }
 
 
@@ -658,7 +707,7 @@ void MinionGraphicsItem::paint(QPainter *painter, const QStyleOptionGraphicsItem
     if(triggerMinion)   painter->setOpacity(0.6);
 
     //Card background
-    painter->setBrush(QBrush(QPixmap(Utility::hscardsPath() + "/" + this->code + ".png")));
+    painter->setBrush(QBrush(Utility::getCardPixmap(this->code)));
     painter->setBrushOrigin(QPointF(100,191));
     painter->drawEllipse(QPointF(0,0), 50, 68);
 
@@ -754,7 +803,7 @@ void MinionGraphicsItem::paint(QPainter *painter, const QStyleOptionGraphicsItem
         }
         else
         {
-            painter->setBrush(QBrush(QPixmap(Utility::hscardsPath() + "/" + addonCode + ".png")));
+            painter->setBrush(QBrush(Utility::getCardPixmap(addonCode)));
             painter->setBrushOrigin(QPointF(100+moveX,202+moveY));
             painter->drawEllipse(QPointF(moveX,moveY), 32, 32);
         }
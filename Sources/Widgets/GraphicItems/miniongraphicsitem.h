@@ -2,6 +2,7 @@
 #define MINIONGRAPHICSITEM_H
 
 #include <QGraphicsItem>
+#include <QDataStream>
 #include "graphicsitemsender.h"
 #include "cardgraphicsitem.h"
 
@@ -26,6 +27,7 @@ public:
 //Constructor
     MinionGraphicsItem(QString code, int id, bool friendly, bool playerTurn, GraphicsItemSender *graphicsItemSender);
     MinionGraphicsItem(MinionGraphicsItem *copy, bool triggerMinion=false);
+    MinionGraphicsItem(QDataStream &stream, GraphicsItemSender *graphicsItemSender);
 
 //Variables
 protected:
@@ -89,6 +91,7 @@ public:
     void updateStatsFromCard(CardGraphicsItem *card);
     void addPlanningAddon(QString code, Addon::AddonType type);
     void changeCode(QString newCode);
+    void saveState(QDataStream &stream, bool asCopy=false);
 
 private:
     void addAddonNeutral(Addon addon);
@@ -29,6 +29,20 @@ WeaponGraphicsItem::WeaponGraphicsItem(WeaponGraphicsItem *copy)
 }
 
 
+WeaponGraphicsItem::WeaponGraphicsItem(QDataStream &stream, GraphicsItemSender *graphicsItemSender)
+    :MinionGraphicsItem(stream, graphicsItemSender)
+{
+    stream >> durability >> origDurability;
+}
+
+
+void WeaponGraphicsItem::saveState(QDataStream &stream, bool asCopy)
+{
+    MinionGraphicsItem::saveState(stream, asCopy);
+    stream << durability << origDurability;
+}
+
+
 QRectF WeaponGraphicsItem::boundingRect() const
 {
     return QRectF( -WIDTH/2, -HEIGHT/2, WIDTH, HEIGHT);
@@ -58,7 +72,7 @@ void WeaponGraphicsItem::paint(QPainter *painter, const QStyleOptionGraphicsItem
     Q_UNUSED(option);
 
     //Card background
-    painter->setBrush(QBrush(QPixmap(Utility::hscardsPath() + "/" + this->code + ".png")));
+    painter->setBrush(QBrush(Utility::getCardPixmap(this->code)));
     painter->setBrushOrigin(QPointF(99,193));
     painter->drawEllipse(QPointF(0,0), 56, 56);
 
@@ -9,6 +9,7 @@ class WeaponGraphicsItem : public MinionGraphicsItem
 public:
     WeaponGraphicsItem(QString code, int id, bool friendly, GraphicsItemSender *graphicsItemSender);
     WeaponGraphicsItem(WeaponGraphicsItem *copy);
+    WeaponGraphicsItem(QDataStream &stream, GraphicsItemSender *graphicsItemSender);
 
 //Variables:
 private:
@@ -23,6 +24,7 @@ public:
     QRectF boundingRect() const Q_DECL_OVERRIDE;
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) Q_DECL_OVERRIDE;
     bool processTagChange(QString tag, QString value);
+    void saveState(QDataStream &stream, bool asCopy=false);
 };
 
 #endif // WEAPONGRAPHICSITEM_H
@@ -65,7 +65,7 @@ void CardWindow::loadCard(QString code, QRect rectCard, int maxTop, int maxBotto
     }
 
     move(moveX, moveY);
-    cardLabel->setPixmap(QPixmap(Utility::hscardsPath() + "/" + code + ".png").copy(5,34,WCARD,HCARD)
+    cardLabel->setPixmap(Utility::getCardPixmap(code, QRect(5,34,WCARD,HCARD))
                          .scaled(winWidth, winHeight, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
     show();
 }
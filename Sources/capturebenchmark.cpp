@@ -0,0 +1,341 @@
+#include "capturebenchmark.h"
+#include <QtConcurrent/QtConcurrent>
+#include <QtWidgets>
+
+
+CaptureBenchmark::CaptureBenchmark()
+{
+    resetPick();
+}
+
+
+void CaptureBenchmark::print(const QString &line)
+{
+    QTextStream out(stdout);
+    out << "Benchmark: " << line << endl;
+}
+
+
+QStringList CaptureBenchmark::readCodes(const QString &path)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))   return QStringList();
+    QStringList codes = QString(file.readAll()).split(QRegularExpression("\\s+"), QString::SkipEmptyParts);
+    file.close();
+    return codes;
+}
+
+
+//Pool completo y de clase igual que DraftHandler::initLightForgeTiers/checkCardsHistReady, pero con el heroe
+//y el pool grabados en dirPath. Los histogramas salen de histograms.cache o se calculan con DraftHandler::computeHistJob.
+bool CaptureBenchmark::loadPool(const QString &dirPath)
+{
+    const QString heroString = Utility::heroString2FromLogNumber(readCodes(dirPath + "/hero.txt").value(0));
+    QStringList poolCodes = readCodes(dirPath + "/pool.txt");
+    const bool lightForgePool = poolCodes.isEmpty();
+    QSet<QString> classCodes;
+
+    QFile jsonFile(Utility::extraPath() + "/lightForge.json");
+    jsonFile.open(QIODevice::ReadOnly | QIODevice::Text);
+    QJsonDocument jsonDoc = QJsonDocument::fromJson(jsonFile.readAll());
+    jsonFile.close();
+    const QJsonArray jsonCardsArray = jsonDoc.object().value("Cards").toArray();
+    for(QJsonValue jsonCard: jsonCardsArray)
+    {
+        QJsonObject jsonCardObject = jsonCard.toObject();
+        QString code = jsonCardObject.value("CardId").toString();
+        if(lightForgePool && !poolCodes.contains(code))     poolCodes.append(code);
+
+        const QJsonArray jsonScoresArray = jsonCardObject.value("Scores").toArray();
+        for(QJsonValue jsonScore: jsonScoresArray)
+        {
+            QString hero = jsonScore.toObject().value("Hero").toString();
+            if(!heroString.isEmpty() && (hero == nullptr || hero == heroString))    classCodes.insert(code);
+        }
+    }
+    if(poolCodes.isEmpty())
+    {
+        print("No pool.txt in " + dirPath + " and no lightForge.json in " + Utility::extraPath() + ".");
+        return false;
+    }
+
+    HistCache histCache;
+    histCache.load(Utility::extraPath() + "/histograms.cache");
+    QMap<QString, cv::MatND> cardsHist;
+    QList<HistJob> histJobs;
+    int missingCards = 0;
+    for(const QString &code: poolCodes)
+    {
+        for(const QString &fileNameCode: {code, code + "_premium"})
+        {
+            //Evitamos golden cards de cartas no colleccionables, igual que DraftHandler::addCardHist
+            if(fileNameCode != code && !Utility::getCardAttribute(code, "collectible").toBool())  continue;
+
+            HistJob histJob;
+            histJob.code = histJob.key = fileNameCode;
+            histJob.filePath = Utility::hscardsPath() + "/" + fileNameCode + ".png";
+            QFileInfo cardFile(histJob.filePath);
+            if(!cardFile.exists())
+            {
+                missingCards++;
+                continue;
+            }
+            histJob.mtime = cardFile.lastModified().toMSecsSinceEpoch();
+            if(!histCache.find(histJob.key, histJob.mtime, cardsHist[fileNameCode]))
+            {
+                cardsHist.remove(fileNameCode);
+                histJobs.append(histJob);
+            }
+        }
+    }
+    if(missingCards > 0)    print(QString::number(missingCards) + " card images missing in " + Utility::hscardsPath() + ".");
+
+    if(!histJobs.isEmpty())
+    {
+        print("Computing " + QString::number(histJobs.count()) + " card histograms.");
+        for(const HistJob &histJob: QtConcurrent::blockingMapped(histJobs, &DraftHandler::computeHistJob))
+        {
+            if(histJob.hist.empty())    continue;
+            cardsHist[histJob.code] = histJob.hist;
+            histCache.insert(histJob.key, histJob.mtime, histJob.hist);
+        }
+        histCache.save();
+    }
+    if(cardsHist.isEmpty())
+    {
+        print("No card histograms for the pool.");
+        return false;
+    }
+
+    QHash<QString, int> rarityGroups = DraftHandler::getRarityGroups(cardsHist);
+    histMatcher.build(cardsHist, rarityGroups);
+
+    QMap<QString, cv::MatND> classHist;
+    for(QMap<QString, cv::MatND>::const_iterator it = cardsHist.cbegin(); it != cardsHist.cend(); it++)
+    {
+        if(classCodes.contains(DraftHandler::degoldCode(it.key())))    classHist.insert(it.key(), it.value());
+    }
+    if(!classHist.isEmpty() && classHist.count() < cardsHist.count())  classHistMatcher.build(classHist, rarityGroups);
+
+    print("Pool: " + QString::number(histMatcher.count()) + " hists, class pool: " +
+          QString::number(classHistMatcher.count()) + " hists.");
+    return true;
+}
+
+
+//Cada pick empieza con el estado de captura limpio, igual que DraftHandler::newCaptureDraftLoop
+void CaptureBenchmark::resetPick()
+{
+    numCaptured = 0;
+    fullPoolCapture = false;
+    captureRarity = captureRarityCandidate = INVALID_RARITY;
+    captureRarityFrames = 0;
+    for(int i=0; i<3; i++)
+    {
+        cardDetected[i] = false;
+        draftCardMaps[i].clear();
+    }
+}
+
+
+const HistMatcher & CaptureBenchmark::captureMatcher() const
+{
+    if(fullPoolCapture || classHistMatcher.isEmpty())   return histMatcher;
+    return classHistMatcher;
+}
+
+
+//Mismas reglas que DraftHandler::updateCaptureRarity.
+void CaptureBenchmark::updateCaptureRarity()
+{
+    if(captureRarity != INVALID_RARITY || numCaptured <= 2)    return;
+
+    CardRarity pickRarity = DraftHandler::getPickRarity(draftCardMaps);
+    if(pickRarity == INVALID_RARITY)
+    {
+        captureRarityFrames = 0;
+        return;
+    }
+
+    if(pickRarity != captureRarityCandidate)
+    {
+        captureRarityCandidate = pickRarity;
+        captureRarityFrames = 0;
+    }
+    if(++captureRarityFrames >= CAPTURE_RARITY_FRAMES)  captureRarity = pickRarity;
+}
+
+
+QString CaptureBenchmark::getBestCode(int index)
+{
+    QString bestCode;
+    double bestMatch = 1;
+    for(QMap<QString, DraftCard>::iterator it=draftCardMaps[index].begin(); it!=draftCardMaps[index].end(); it++)
+    {
+        if(it->getBestQualityMatches() <= bestMatch)
+        {
+            bestMatch = it->getBestQualityMatches();
+            bestCode = DraftHandler::degoldCode(it.key());
+        }
+    }
+    return bestCode;
+}
+
+
+QString CaptureBenchmark::percentilesString(QVector<qint64> times)
+{
+    if(times.isEmpty()) return "no samples";
+
+    std::sort(times.begin(), times.end());
+    QString text;
+    const int percentiles[] = {50, 90, 99};
+    for(int percentile: percentiles)
+    {
+        int index = std::min(times.count() - 1, (times.count() * percentile) / 100);
+        text += "p" + QString::number(percentile) + " " + QString::number(times[index]/1000000.0, 'f', 2) + "ms ";
+    }
+    return text.trimmed();
+}
+
+
+//Cada captura pasa por las mismas etapas que DraftHandler::captureDraft:
+//findScreenRects, getScreenCardsHist, matchCaptureHist/updateFullPoolCapture y mapBestMatchingCodes/areCardsDetected.
+bool CaptureBenchmark::run(const QString &dirPath)
+{
+    if(!Utility::loadCardsBin())
+    {
+        print("Cannot read " + Utility::extraPath() + "/cards.bin. Run Arena Tracker once to create it.");
+        return false;
+    }
+    if(!loadPool(dirPath))  return false;
+
+    ScreenLocator screenLocator;
+    const std::vector<Point2f> templatePoints = DraftHandler::getTemplatePoints(true);
+    cv::Mat screenHsv[3];
+    cv::MatND screenHist[3];
+    QVector<qint64> locateTimes, histTimes, matchTimes, mapTimes;
+    int numFrames = 0, top1 = 0, top3 = 0;
+    int numPicks = 0, picksDetected = 0, picksCorrect = 0, framesToDetection = 0;
+    QElapsedTimer timer;
+
+    QDir dir(dirPath);
+    foreach(const QString &pickName, dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name))
+    {
+        QDir pickDir(dir.filePath(pickName));
+        QStringList trueCodes = readCodes(pickDir.filePath("codes.txt"));
+        if(trueCodes.isEmpty()) continue;
+        if(trueCodes.count() != 3)
+        {
+            print(pickName + "/codes.txt needs 3 codes.");
+            continue;
+        }
+
+        numPicks++;
+        resetPick();
+        int detectedFrame = -1;
+
+        QStringList frames = pickDir.entryList(QStringList() << "*.png", QDir::Files, QDir::Name);
+        for(int frame=0; frame<frames.count() && detectedFrame == -1; frame++)
+        {
+            cv::Mat image = cv::imread(pickDir.filePath(frames[frame]).toStdString());
+            if(!image.data) continue;
+
+            //findScreenRects
+            timer.start();
+            std::vector<Point2f> screenPoints = screenLocator.findTemplateOnImage("arenaTemplate.png", image, "benchmark", templatePoints);
+            locateTimes.append(timer.nsecsElapsed());
+            if(screenPoints.empty())    continue;
+
+            cv::Rect imageRect(0, 0, image.cols, image.rows);
+            cv::Mat bigCards[3];
+            bool validRects = true;
+            for(int i=0; i<3; i++)
+            {
+                cv::Rect cardRect = cv::Rect(screenPoints[static_cast<ulong>(i*2)], screenPoints[static_cast<ulong>(i*2+1)]) & imageRect;
+                if(cardRect.area() == 0)    validRects = false;
+                else                        bigCards[i] = image(cardRect);
+            }
+            if(!validRects) continue;
+
+            //getScreenCardsHist
+            timer.start();
+            for(int i=0; i<3; i++)  DraftHandler::getHist(bigCards[i], screenHsv[i], screenHist[i]);
+            histTimes.append(timer.nsecsElapsed());
+
+            //matchCaptureHist + updateFullPoolCapture
+            timer.start();
+            cv::Mat distances;
+            DraftHandler::matchRarityRange(captureMatcher(), captureRarity, screenHist, distances);
+            if(!fullPoolCapture && !classHistMatcher.isEmpty() && numCaptured > 2 &&
+                !distances.empty() && !DraftHandler::isClassPoolConfident(distances))
+            {
+                fullPoolCapture = true;
+                DraftHandler::matchRarityRange(captureMatcher(), captureRarity, screenHist, distances);
+            }
+            const HistMatcher &matcher = captureMatcher();
+            matchTimes.append(timer.nsecsElapsed());
+            if(distances.empty())   continue;
+
+            //mapBestMatchingCodes
+            timer.start();
+            DraftHandler::mapBestMatchingCodes(matcher, distances, draftCardMaps, numCaptured, CAPTURE_MIN_CANDIDATES);
+            updateCaptureRarity();
+            bool detected = DraftHandler::areCardsDetected(draftCardMaps, cardDetected, numCaptured);
+            mapTimes.append(timer.nsecsElapsed());
+
+            //Precision de un solo frame
+            numFrames++;
+            for(int i=0; i<3; i++)
+            {
+                QVector<int> best = HistMatcher::topK(distances, i, 3);
+                for(int k=0; k<best.count(); k++)
+                {
+                    if(DraftHandler::degoldCode(matcher.getCode(best[k])) == trueCodes[i])
+                    {
+                        if(k == 0)  top1++;
+                        top3++;
+                        break;
+                    }
+                }
+            }
+
+            if(detected)
+            {
+                detectedFrame = frame + 1;
+                picksDetected++;
+                framesToDetection += detectedFrame;
+
+                bool correct = true;
+                for(int i=0; i<3; i++)
+                {
+                    if(getBestCode(i) != trueCodes[i])  correct = false;
+                }
+                if(correct) picksCorrect++;
+                else        print(pickName + " detected wrong cards.");
+            }
+        }
+
+        if(detectedFrame == -1) print(pickName + " not detected.");
+    }
+
+    print(QString::number(numPicks) + " picks, " + QString::number(numFrames) + " frames.");
+    if(numFrames > 0)
+    {
+        print("Top-1 " + QString::number(100.0*top1/(3*numFrames), 'f', 1) + "% - Top-3 " +
+              QString::number(100.0*top3/(3*numFrames), 'f', 1) + "% (single frame).");
+    }
+    if(numPicks > 0)
+    {
+        print("Detected " + QString::number(picksDetected) + "/" + QString::number(numPicks) +
+              " picks, " + QString::number(picksCorrect) + " correct.");
+    }
+    if(picksDetected > 0)
+    {
+        print("Frames to detection: " + QString::number(framesToDetection/static_cast<double>(picksDetected), 'f', 1));
+    }
+    print("Locate - " + percentilesString(locateTimes));
+    print("Hist - " + percentilesString(histTimes));
+    print("Match - " + percentilesString(matchTimes));
+    print("Map - " + percentilesString(mapTimes));
+    return true;
+}
@@ -0,0 +1,54 @@
+#ifndef CAPTUREBENCHMARK_H
+#define CAPTUREBENCHMARK_H
+
+#include "drafthandler.h"
+#include <QString>
+#include <QStringList>
+#include <QSet>
+#include <QMap>
+
+
+//Benchmark offline del reconocimiento de cartas del draft, para evaluar cambios en los histogramas o en el matcher.
+//Se lanza con "ArenaTracker --benchmark <dir>" (ver main.cpp), sin cliente de Hearthstone ni draft en curso.
+//Construye sus propios HistMatcher con el pool grabado en dir y aplica las mismas reglas de pick que
+//DraftHandler::captureDraft (funciones estaticas de DraftHandler) sobre su propio estado.
+//dir contiene:
+// - hero.txt: log number del heroe del draft (p.ej. 07), para el pool de clase (clase del heroe + neutrales).
+// - pool.txt: codes del pool de arena. Si no existe se usan todas las cartas de lightForge.json (multiclass).
+// - Un directorio por pick con capturas de pantalla (png, se procesan por orden de nombre)
+//   y un codes.txt con los 3 codes correctos.
+class CaptureBenchmark
+{
+//Constructor
+public:
+    CaptureBenchmark();
+
+//Variables
+private:
+    HistMatcher histMatcher;
+    HistMatcher classHistMatcher;       //Solo si el pool de clase es menor que el pool completo
+    //Estado del pick, igual que en DraftHandler
+    QMap<QString, DraftCard> draftCardMaps[3];  //[Code(_premium)] --> DraftCard
+    bool cardDetected[3];
+    int numCaptured;
+    bool fullPoolCapture;
+    CardRarity captureRarity;
+    CardRarity captureRarityCandidate;
+    int captureRarityFrames;
+
+//Metodos
+private:
+    bool loadPool(const QString &dirPath);
+    static void print(const QString &line);
+    static QStringList readCodes(const QString &path);
+    void resetPick();
+    const HistMatcher & captureMatcher() const;
+    void updateCaptureRarity();
+    QString getBestCode(int index);
+    static QString percentilesString(QVector<qint64> times);
+
+public:
+    bool run(const QString &dirPath);
+};
+
+#endif // CAPTUREBENCHMARK_H
@@ -9,6 +9,10 @@ DraftHandler::DraftHandler(QObject *parent, Ui::Extended *ui) : QObject(parent)
     this->deckRatingHA = this->deckRatingLF = 0;
     this->numCaptured = 0;
     this->extendedCapture = false;
+    this->fullPoolCapture = false;
+    this->captureRarity = this->captureRarityCandidate = INVALID_RARITY;
+    this->captureRarityFrames = 0;
+    this->classHistJobsLeft = this->otherHistJobsLeft = 0;
     this->drafting = false;
     this->heroDrafting = false;
     this->capturing = false;
@@ -34,11 +38,15 @@ DraftHandler::DraftHandler(QObject *parent, Ui::Extended *ui) : QObject(parent)
     buildHeroCodesList();
     completeUI();
 
+    connect(&futureFindScreenRects, SIGNAL(resultReadyAt(int)), this, SLOT(addScreenDetection(int)));
     connect(&futureFindScreenRects, SIGNAL(finished()), this, SLOT(finishFindScreenRects()));
+    connect(&futureHists, SIGNAL(resultReadyAt(int)), this, SLOT(addComputedHist(int)));
+    connect(&futureHists, SIGNAL(finished()), this, SLOT(finishHistJobs()));
 }
 
 DraftHandler::~DraftHandler()
 {
+    cancelHistJobs();
     deleteDraftHeroWindow();
     deleteDraftScoreWindow();
     deleteDraftMechanicsWindow();
@@ -252,7 +260,13 @@ void DraftHandler::addCardHist(QString code, bool premium, bool isHero)
     QFileInfo cardFile(Utility::hscardsPath() + "/" + fileNameCode + ".png");
     if(cardFile.exists())
     {
-        cardsHist[fileNameCode] = getHist(fileNameCode);
+        //Los que no estan en histCache se calculan en paralelo en startHistJobs
+        HistJob histJob = newHistJob(fileNameCode);
+        if(!histCache.find(histJob.key, histJob.mtime, cardsHist[fileNameCode]))
+        {
+            cardsHist.remove(fileNameCode);
+            histJobs.append(histJob);
+        }
     }
     else
     {
@@ -283,6 +297,7 @@ QMap<QString, LFtier> DraftHandler::initLightForgeTiers(const QString &heroStrin
             QJsonObject jsonScoreObject = jsonScore.toObject();
             QString hero = jsonScoreObject.value("Hero").toString();
 
+            if(hero == nullptr || hero == heroString)   classCodes.insert(code);
             if(multiClassDraft || hero == nullptr || hero == heroString)
             {
                 LFtier lfTier;
@@ -324,8 +339,13 @@ QMap<QString, LFtier> DraftHandler::initLightForgeTiers(const QString &heroStrin
 
 void DraftHandler::initCodesAndHistMaps(QString hero)
 {
+    cancelHistJobs();
     cardsDownloading.clear();
     cardsHist.clear();
+    histMatcher.clear();
+    classHistMatcher.clear();
+    classCodes.clear();
+    histCache.load(Utility::extraPath() + "/histograms.cache");
 
     if(drafting)
     {
@@ -344,15 +364,191 @@ void DraftHandler::initCodesAndHistMaps(QString hero)
     }
 
     //Wait for cards
+    if(!cardsDownloading.isEmpty())
+    {
+        emit startProgressBar(cardsDownloading.count(), "Downloading cards...");
+        emit downloadStarted();
+    }
+    startHistJobs();
+    checkCardsHistReady();
+}
+
+
+HistJob DraftHandler::newHistJob(const QString &code)
+{
+    HistJob histJob;
+    histJob.code = code;
+    histJob.key = drafting?code:("hero/" + code);
+    histJob.filePath = Utility::hscardsPath() + "/" + code + ".png";
+    histJob.mtime = QFileInfo(histJob.filePath).lastModified().toMSecsSinceEpoch();
+    histJob.drafting = drafting;
+    return histJob;
+}
+
+
+//Se ejecuta en el thread pool, no puede tocar miembros de DraftHandler.
+HistJob DraftHandler::computeHistJob(const HistJob &histJob)
+{
+    HistJob result = histJob;
+    cv::Mat fullCard = cv::imread(histJob.filePath.toStdString(), CV_LOAD_IMAGE_COLOR);
+    if(fullCard.empty())    return result;
+
+    cv::Mat srcBase;
+    if(histJob.drafting)
+    {
+        if(histJob.code.endsWith("_premium"))   srcBase = fullCard(cv::Rect(57,71,80,80));
+        else                                    srcBase = fullCard(cv::Rect(60,71,80,80));
+    }
+    else //if(heroDrafting)
+    {
+        srcBase = fullCard(cv::Rect(75,201,160,160));
+//#ifdef QT_DEBUG
+//        cv::imshow(code.toStdString(), srcBase);
+//#endif
+    }
+    result.hist = getHist(srcBase);
+    return result;
+}
+
+
+void DraftHandler::startHistJobs()
+{
+    if(histJobs.isEmpty())  return;
+
+    //Las cartas de clase + neutrales van delante, asi classHistMatcher esta listo antes que el pool completo
+    QList<HistJob> classJobs, otherJobs;
+    for(const HistJob &histJob: histJobs)
+    {
+        if(drafting && classCodes.contains(degoldCode(histJob.code)))   classJobs.append(histJob);
+        else                                                            otherJobs.append(histJob);
+    }
+    classHistJobsLeft = classJobs.count();
+    otherHistJobsLeft = otherJobs.count();
+    histJobs = classJobs + otherJobs;
+
+    emit pDebug("Computing " + QString::number(histJobs.count()) + " card histograms.");
+    if(cardsDownloading.isEmpty())  emit startProgressBar(histJobs.count(), "Reading cards...");
+    futureHists.setFuture(QtConcurrent::mapped(histJobs, &DraftHandler::computeHistJob));
+}
+
+
+void DraftHandler::cancelHistJobs()
+{
+    if(futureHists.isRunning())
+    {
+        futureHists.cancel();
+        futureHists.waitForFinished();
+    }
+    histJobs.clear();
+    classHistJobsLeft = otherHistJobsLeft = 0;
+}
+
+
+void DraftHandler::addComputedHist(int index)
+{
+    if(futureHists.isCanceled())    return;
+
+    HistJob histJob = futureHists.resultAt(index);
+    if(!histJob.hist.empty())
+    {
+        cardsHist[histJob.code] = histJob.hist;
+        histCache.insert(histJob.key, histJob.mtime, histJob.hist);
+    }
     if(cardsDownloading.isEmpty())
     {
-        newCaptureDraftLoop();
+        emit advanceProgressBar(histJobs.count() - futureHists.progressValue(), histJob.code.split("_premium").first() + " read");
     }
-    else
+
+    if(drafting && classCodes.contains(degoldCode(histJob.code)))
     {
-        emit startProgressBar(cardsDownloading.count(), "Downloading cards...");
-        emit downloadStarted();
+        if(--classHistJobsLeft == 0)    checkClassHistReady();
+    }
+    else    otherHistJobsLeft--;
+}
+
+
+void DraftHandler::finishHistJobs()
+{
+    if(futureHists.isCanceled())    return;
+
+    if(cardsDownloading.isEmpty())  emit showMessageProgressBar("All cards read", 1000);
+    histJobs.clear();
+    checkCardsHistReady();
+}
+
+
+//El capture loop empieza cuando todos los histogramas del pool estan listos (descargas y thread pool),
+//o antes con classHistMatcher si las cartas de clase + neutrales terminan primero (checkClassHistReady).
+void DraftHandler::checkCardsHistReady()
+{
+    if(!cardsDownloading.isEmpty() || !histJobs.isEmpty())
+    {
+        checkClassHistReady();
+        return;
+    }
+
+    histCache.save();
+
+    if(drafting)
+    {
+        //Agrupadas por rareza para poder descartar legendarias/no legendarias (matchRarityRange)
+        QHash<QString, int> rarityGroups = getRarityGroups(cardsHist);
+        histMatcher.build(cardsHist, rarityGroups);
+
+        //En multiclass el pool incluye todas las clases, buscamos primero en las cartas de la clase del heroe
+        QMap<QString, cv::MatND> classHist;
+        for(QMap<QString, cv::MatND>::const_iterator it = cardsHist.cbegin(); it != cardsHist.cend(); it++)
+        {
+            if(classCodes.contains(degoldCode(it.key())))  classHist.insert(it.key(), it.value());
+        }
+        if(classHist.count() < cardsHist.count())
+        {
+            //Puede estar ya creado por checkClassHistReady, con los mismos histogramas
+            if(classHistMatcher.count() != classHist.count())   classHistMatcher.build(classHist, rarityGroups);
+            emit pDebug("Class pool: " + QString::number(classHistMatcher.count()) + "/" + QString::number(histMatcher.count()) + " hists.");
+        }
+        else    classHistMatcher.clear();
+    }
+    else //if(heroDrafting)
+    {
+        histMatcher.build(cardsHist);
     }
+    //captureDistances puede ser de un matcher que ya no es captureMatcher()
+    captureDistances.release();
+    newCaptureDraftLoop();
+}
+
+
+//Las cartas de clase + neutrales ya estan (descargadas y calculadas) pero quedan otras del pool completo:
+//empezamos a capturar con classHistMatcher, histMatcher se construye despues en checkCardsHistReady.
+void DraftHandler::checkClassHistReady()
+{
+    if(!drafting || !classHistMatcher.isEmpty() || classHistJobsLeft > 0)   return;
+
+    bool otherCardsPending = (otherHistJobsLeft > 0);
+    for(const QString &fileNameCode: cardsDownloading)
+    {
+        if(classCodes.contains(degoldCode(fileNameCode)))   return;
+        otherCardsPending = true;
+    }
+    if(!otherCardsPending)  return;
+
+    QMap<QString, cv::MatND> classHist;
+    for(QMap<QString, cv::MatND>::const_iterator it = cardsHist.cbegin(); it != cardsHist.cend(); it++)
+    {
+        if(classCodes.contains(degoldCode(it.key())))  classHist.insert(it.key(), it.value());
+    }
+    if(classHist.isEmpty())     return;
+
+    classHistMatcher.build(classHist, getRarityGroups(classHist));
+    emit pDebug("Class pool ready: " + QString::number(classHistMatcher.count()) + " hists. Capturing before the full pool.");
+    newCaptureDraftLoop();
+}
+
+
+bool DraftHandler::isCaptureMatcherReady() const
+{
+    return !histMatcher.isEmpty() || !classHistMatcher.isEmpty();
 }
 
 
@@ -367,8 +563,8 @@ void DraftHandler::reHistDownloadedCardImage(const QString &fileNameCode, bool m
     {
         emit showMessageProgressBar("All cards downloaded");
         emit downloadEnded();
-        newCaptureDraftLoop();
     }
+    checkCardsHistReady();
 }
 
 
@@ -423,7 +619,12 @@ void DraftHandler::clearLists(bool keepCounters)
     synergyHandler->clearLists(keepCounters);//keepCounters = beginDraft
     hearthArenaTiers.clear();
     lightForgeTiers.clear();
+    cancelHistJobs();
     cardsHist.clear();
+    histCache.clear();
+    histMatcher.clear();
+    classHistMatcher.clear();
+    classCodes.clear();
 
     if(!keepCounters)//endDraft
     {
@@ -715,10 +916,15 @@ void DraftHandler::deleteDraftMechanicsWindow()
 
 void DraftHandler::newCaptureDraftLoop(bool delayed)
 {
-    if(!capturing && screenFound() && cardsDownloading.isEmpty() &&
+    if(!capturing && screenFound() && isCaptureMatcherReady() &&
         ((drafting && !lightForgeTiers.empty() && !hearthArenaTiers.empty()) || heroDrafting))
     {
         capturing = true;
+        for(int i=0; i<3; i++)  captureThumbs[i].release();
+        captureDistances.release();
+        fullPoolCapture = false;
+        captureRarity = captureRarityCandidate = INVALID_RARITY;
+        captureRarityFrames = 0;
 
         if(delayed)                 QTimer::singleShot(CAPTUREDRAFT_START_TIME, this, SLOT(captureDraft()));
         else                        captureDraft();
@@ -733,22 +939,27 @@ void DraftHandler::captureDraft()
 
     bool missingTierLists = drafting && (lightForgeTiers.empty() || hearthArenaTiers.empty());
     if((!drafting && !heroDrafting) || missingTierLists ||
-        leavingArena || !screenFound() || !cardsDownloading.isEmpty())
+        leavingArena || !screenFound() || !isCaptureMatcherReady())
     {
         leavingArena = false;
         capturing = false;
         return;
     }
 
-    cv::MatND screenCardsHist[3];
-    if(!getScreenCardsHist(screenCardsHist))
+    //Si las cartas en pantalla no han cambiado nos ahorramos histogramas y match, repetimos las distancias anteriores
+    bool screenChanged;
+    if(!getScreenCardsHist(captureHist, screenChanged))
     {
         capturing = false;
         return;
     }
-    mapBestMatchingCodes(screenCardsHist);
+    if(screenChanged || captureDistances.empty())  matchCaptureHist(captureHist, captureDistances);
+    updateFullPoolCapture(captureHist, captureDistances);
+    mapBestMatchingCodes(captureMatcher(), captureDistances, draftCardMaps, numCaptured,
+                         extendedCapture?CAPTURE_EXTENDED_CANDIDATES:CAPTURE_MIN_CANDIDATES);
+    updateCaptureRarity();
 
-    if(areCardsDetected())
+    if(areCardsDetected(draftCardMaps, cardDetected, numCaptured))
     {
         capturing = false;
         buildBestMatchesMaps();
@@ -766,13 +977,15 @@ void DraftHandler::captureDraft()
     }
     else
     {
-        if(numCaptured == 0)    QTimer::singleShot(CAPTUREDRAFT_LOOP_TIME_FADING, this, SLOT(captureDraft()));
-        else                    QTimer::singleShot(CAPTUREDRAFT_LOOP_TIME, this, SLOT(captureDraft()));
+        //Mientras las cartas estan apareciendo (la pantalla cambia) volvemos a capturar enseguida
+        if(numCaptured == 0 && !screenChanged)  QTimer::singleShot(CAPTUREDRAFT_LOOP_TIME_FADING, this, SLOT(captureDraft()));
+        else                                    QTimer::singleShot(CAPTUREDRAFT_LOOP_TIME, this, SLOT(captureDraft()));
     }
 }
 
 
-bool DraftHandler::areCardsDetected()
+//Estatica (igual que el resto de reglas del pick) para que CaptureBenchmark use las mismas con su propio estado.
+bool DraftHandler::areCardsDetected(QMap<QString, DraftCard> draftCardMaps[3], bool cardDetected[3], int numCaptured)
 {
     for(int i=0; i<3; i++)
     {
@@ -1215,23 +1428,36 @@ void DraftHandler::showNewRatings(float rating1, float rating2, float rating3,
 }
 
 
-bool DraftHandler::getScreenCardsHist(cv::MatND screenCardsHist[3])
+bool DraftHandler::getScreenCardsHist(cv::MatND screenCardsHist[3], bool &screenChanged)
 {
     QList<QScreen *> screens = QGuiApplication::screens();
     if(screenIndex >= screens.count() || screenIndex < 0)  return false;
     QScreen *screen = screens[screenIndex];
     if (!screen) return false;
 
+    //Solo capturamos el rectangulo que contiene las 3 cartas (screenRects estan en pixeles, grabWindow usa coordenadas logicas)
+    if(screenScale.x() <= 0 || screenScale.y() <= 0)   return false;
+    cv::Rect captureRect = screenRects[0] | screenRects[1] | screenRects[2];
     QRect rect = screen->geometry();
-    QImage image = screen->grabWindow(0,rect.x(),rect.y(),rect.width(),rect.height()).toImage();
-    cv::Mat mat(image.height(),image.width(),CV_8UC4,image.bits(), static_cast<ulong>(image.bytesPerLine()));
-
-    cv::Mat screenCapture = mat.clone();
+    int logicalX = static_cast<int>(captureRect.x * screenScale.x());
+    int logicalY = static_cast<int>(captureRect.y * screenScale.y());
+    int logicalWidth = static_cast<int>(std::ceil((captureRect.x + captureRect.width) * screenScale.x())) - logicalX;
+    int logicalHeight = static_cast<int>(std::ceil((captureRect.y + captureRect.height) * screenScale.y())) - logicalY;
+    QImage image = screen->grabWindow(0, rect.x() + logicalX, rect.y() + logicalY, logicalWidth, logicalHeight).toImage();
+    if(image.isNull())  return false;
+
+    //El QImage sigue vivo mientras usamos screenCapture, no hace falta clone
+    cv::Mat screenCapture(image.height(),image.width(),CV_8UC4,image.bits(), static_cast<ulong>(image.bytesPerLine()));
+    cv::Point origin(qRound(logicalX / screenScale.x()), qRound(logicalY / screenScale.y()));
+    cv::Rect imageRect(0, 0, image.width(), image.height());
 
     cv::Mat bigCards[3];
-    bigCards[0] = screenCapture(screenRects[0]);
-    bigCards[1] = screenCapture(screenRects[1]);
-    bigCards[2] = screenCapture(screenRects[2]);
+    for(int i=0; i<3; i++)
+    {
+        cv::Rect cardRect = (screenRects[i] - origin) & imageRect;
+        if(cardRect.area() == 0)    return false;
+        bigCards[i] = screenCapture(cardRect);
+    }
 
 
 //#ifdef QT_DEBUG
@@ -1240,11 +1466,37 @@ bool DraftHandler::getScreenCardsHist(cv::MatND screenCardsHist[3])
 //    cv::imshow("Card3", bigCards[2]);
 //#endif
 
-    for(int i=0; i<3; i++)  screenCardsHist[i] = getHist(bigCards[i]);
+    screenChanged = updateCaptureThumbs(bigCards);
+    if(screenChanged)
+    {
+        for(int i=0; i<3; i++)  getHist(bigCards[i], captureHsv[i], screenCardsHist[i]);
+    }
     return true;
 }
 
 
+//Reduce cada carta a una miniatura y la compara (diferencia absoluta media) con la de la captura anterior.
+//Devuelve true si alguna de las 3 ha cambiado o no habia captura anterior.
+bool DraftHandler::updateCaptureThumbs(cv::Mat bigCards[3])
+{
+    bool changed = false;
+    cv::Mat thumb;
+
+    for(int i=0; i<3; i++)
+    {
+        cv::resize(bigCards[i], thumb, cv::Size(CAPTURE_THUMB_SIZE, CAPTURE_THUMB_SIZE), 0, 0, cv::INTER_AREA);
+        if(captureThumbs[i].empty() ||
+            cv::norm(thumb, captureThumbs[i], cv::NORM_L1)/(thumb.total()*thumb.channels()) > CAPTURE_DIFF_THRESHOLD)
+        {
+            changed = true;
+        }
+        thumb.copyTo(captureThumbs[i]);
+    }
+
+    return changed;
+}
+
+
 bool DraftHandler::isGoldCode(QString fileName)
 {
     return fileName.endsWith("_premium");
@@ -1259,39 +1511,169 @@ QString DraftHandler::degoldCode(QString fileName)
 }
 
 
-void DraftHandler::mapBestMatchingCodes(cv::MatND screenCardsHist[3])
+//Busca en el pool de la clase del heroe hasta que updateFullPoolCapture pase al pool completo.
+void DraftHandler::matchCaptureHist(cv::MatND hists[3], cv::Mat &distances)
 {
-    bool newCardsFound = false;
-    const int numCandidates = (extendedCapture?CAPTURE_EXTENDED_CANDIDATES:CAPTURE_MIN_CANDIDATES);
+    matchRarityRange(captureMatcher(), captureRarity, hists, distances);
+}
+
+
+//Se comprueba en cada captura, tambien cuando se reutiliza captureDistances porque la pantalla no ha cambiado.
+//Si ya hemos empezado a contar (numCaptured > 2) y alguna carta no se parece lo suficiente a ninguna de la clase
+//pasamos al pool completo hasta el final del pick y repetimos el match en esta misma captura.
+//El pool completo contiene al de clase, asi que los candidatos ya acumulados en draftCardMaps siguen siendo validos.
+void DraftHandler::updateFullPoolCapture(cv::MatND hists[3], cv::Mat &distances)
+{
+    if(fullPoolCapture || classHistMatcher.isEmpty() || histMatcher.isEmpty() ||
+        numCaptured <= 2 || distances.empty() || isClassPoolConfident(distances))   return;
+
+    fullPoolCapture = true;
+    emit pDebug("Low confidence on class pool. Matching against the full pool.");
+    matchCaptureHist(hists, distances);
+}
+
 
+//Todas las cartas tienen algun candidato de la clase por debajo de CLASS_POOL_THRESHOLD.
+bool DraftHandler::isClassPoolConfident(const cv::Mat &distances)
+{
     for(int i=0; i<3; i++)
     {
-        QMap<double, QString> bestMatchesMap;
-        for(QMap<QString, cv::MatND>::const_iterator it=cardsHist.constBegin(); it!=cardsHist.constEnd(); it++)
+        double minDistance;
+        cv::minMaxLoc(distances.row(i), &minDistance);
+        if(minDistance > CLASS_POOL_THRESHOLD)  return false;
+    }
+    return true;
+}
+
+
+//Con la rareza del pick ya deducida solo comparamos contra las cartas de esa rareza (y las que no tienen rareza).
+void DraftHandler::matchRarityRange(const HistMatcher &matcher, CardRarity rarity, cv::MatND hists[3], cv::Mat &distances)
+{
+    if(rarity == INVALID_RARITY || matcher.groupCount() <= RARITY_GROUP_NON_LEGENDARY)
+    {
+        matcher.match(hists, 3, distances);
+    }
+    else if(rarity == LEGENDARY)
+    {
+        matcher.match(hists, 3, distances, matcher.groupBegin(RARITY_GROUP_LEGENDARY), matcher.groupEnd(RARITY_GROUP_OTHER));
+    }
+    else
+    {
+        matcher.match(hists, 3, distances, matcher.groupBegin(RARITY_GROUP_OTHER), matcher.groupEnd(RARITY_GROUP_NON_LEGENDARY));
+    }
+}
+
+
+//Las 3 cartas de un pick son todas legendarias o ninguna (ver getBestRarity). Solo fijamos la rareza del pick
+//cuando la mejor carta de cada una de las 3 posiciones es coleccionable, supera CARD_ACCEPTED_THRESHOLD y las 3
+//coinciden en legendaria/no legendaria durante CAPTURE_RARITY_FRAMES capturas seguidas. Un solo match erroneo
+//no puede descartar la rareza correcta, las siguientes comparaciones descartan la otra.
+void DraftHandler::updateCaptureRarity()
+{
+    if(!drafting || captureRarity != INVALID_RARITY || numCaptured <= 2)   return;
+
+    CardRarity pickRarity = getPickRarity(draftCardMaps);
+    if(pickRarity == INVALID_RARITY)
+    {
+        captureRarityFrames = 0;
+        return;
+    }
+
+    if(pickRarity != captureRarityCandidate)
+    {
+        captureRarityCandidate = pickRarity;
+        captureRarityFrames = 0;
+    }
+    if(++captureRarityFrames < CAPTURE_RARITY_FRAMES)   return;
+
+    captureRarity = pickRarity;
+    captureDistances.release();     //El siguiente captureDraft repite el match ya filtrado por rareza
+    emit pDebug(QString("Pick rarity: ") + (captureRarity == LEGENDARY?"Legendary":"Non legendary"));
+}
+
+
+//LEGENDARY/COMMON(no legendaria) si las mejores cartas de las 3 posiciones son coleccionables, superan
+//CARD_ACCEPTED_THRESHOLD y coinciden. INVALID_RARITY en otro caso.
+CardRarity DraftHandler::getPickRarity(QMap<QString, DraftCard> draftCardMaps[3])
+{
+    CardRarity pickRarity = INVALID_RARITY;
+    for(int i=0; i<3; i++)
+    {
+        QString bestCode;
+        double bestMatch = CARD_ACCEPTED_THRESHOLD;
+        for(QMap<QString, DraftCard>::iterator it=draftCardMaps[i].begin(); it!=draftCardMaps[i].end(); it++)
         {
-            double match = compareHist(screenCardsHist[i], it.value(), 3);
-            QString code = it.key();
-            bestMatchesMap.insertMulti(match, code);
+            if(it->getBestQualityMatches() < bestMatch)
+            {
+                bestMatch = it->getBestQualityMatches();
+                bestCode = degoldCode(it.key());
+            }
+        }
+
+        if(bestCode.isEmpty() || !Utility::getCardAttribute(bestCode, "collectible").toBool())  return INVALID_RARITY;
+        CardRarity rarity = (Utility::getRarityFromCode(bestCode) == LEGENDARY)?LEGENDARY:COMMON;
+        if(i > 0 && rarity != pickRarity)   return INVALID_RARITY;
+        pickRarity = rarity;
+    }
+    return pickRarity;
+}
 
-            //Actualizamos DraftCardMaps con los nuevos resultados
-            if((numCaptured != 0) && draftCardMaps[i].contains(code))
+
+QHash<QString, int> DraftHandler::getRarityGroups(const QMap<QString, cv::MatND> &hists)
+{
+    QHash<QString, int> groups;
+    for(const QString &fileNameCode: hists.keys())
+    {
+        QString code = degoldCode(fileNameCode);
+        CardRarity rarity = Utility::getRarityFromCode(code);
+        if(!Utility::getCardAttribute(code, "collectible").toBool() || rarity == INVALID_RARITY)
+        {
+            groups[fileNameCode] = RARITY_GROUP_OTHER;
+        }
+        else if(rarity == LEGENDARY)    groups[fileNameCode] = RARITY_GROUP_LEGENDARY;
+        else                            groups[fileNameCode] = RARITY_GROUP_NON_LEGENDARY;
+    }
+    return groups;
+}
+
+
+//histMatcher puede no estar listo todavia si la captura empezo solo con classHistMatcher (checkClassHistReady).
+const HistMatcher & DraftHandler::captureMatcher() const
+{
+    if(classHistMatcher.isEmpty() || (fullPoolCapture && !histMatcher.isEmpty()))  return histMatcher;
+    return classHistMatcher;
+}
+
+
+void DraftHandler::mapBestMatchingCodes(const HistMatcher &matcher, const cv::Mat &distances,
+                                        QMap<QString, DraftCard> draftCardMaps[3], int &numCaptured, int numCandidates)
+{
+    bool newCardsFound = false;
+
+    if(distances.empty())   return;
+
+    for(int i=0; i<3; i++)
+    {
+        //Actualizamos DraftCardMaps con los nuevos resultados
+        if(numCaptured != 0)
+        {
+            for(QMap<QString, DraftCard>::iterator it=draftCardMaps[i].begin(); it!=draftCardMaps[i].end(); it++)
             {
-                draftCardMaps[i][code].setBestQualityMatch(match, false);
+                int index = matcher.getIndex(it.key());
+                if(index != -1)     it->setBestQualityMatch(static_cast<double>(distances.at<float>(i, index)), false);
             }
         }
 
         //Incluimos en DraftCardMaps los mejores 7 matches, si no han sido ya actualizados por estar en el map.
-        QList<double> bestMatchesList = bestMatchesMap.keys();
-        for(int j=0; j<numCandidates && j<bestMatchesList.count(); j++)
+        for(int index: HistMatcher::topK(distances, i, numCandidates))
         {
-            double match = bestMatchesList.at(j);
-            QString code = bestMatchesMap[match];
+            QString code = matcher.getCode(index);
 
             if(!draftCardMaps[i].contains(code))
             {
                 newCardsFound = true;
                 draftCardMaps[i].insert(code, DraftCard(degoldCode(code)));
-                if(numCaptured != 0)    draftCardMaps[i][code].setBestQualityMatch(match, true);
+                if(numCaptured != 0)    draftCardMaps[i][code].setBestQualityMatch(static_cast<double>(distances.at<float>(i, index)), true);
             }
         }
     }
@@ -1305,7 +1687,7 @@ void DraftHandler::mapBestMatchingCodes(cv::MatND screenCardsHist[3])
             for(int i=0; i<3; i++)  draftCardMaps[i].clear();
         }
 
-        this->numCaptured++;
+        numCaptured++;
     }
 
 
@@ -1325,35 +1707,36 @@ void DraftHandler::mapBestMatchingCodes(cv::MatND screenCardsHist[3])
 }
 
 
+//Usa histCache si el png no ha cambiado desde que se calculo.
 cv::MatND DraftHandler::getHist(const QString &code)
 {
-    cv::Mat fullCard = cv::imread((Utility::hscardsPath() + "/" + code + ".png").toStdString(), CV_LOAD_IMAGE_COLOR);
-    cv::Mat srcBase;
-    if(drafting)
-    {
-        if(code.endsWith("_premium"))   srcBase = fullCard(cv::Rect(57,71,80,80));
-        else                            srcBase = fullCard(cv::Rect(60,71,80,80));
-    }
-    else //if(heroDrafting)
-    {
-        srcBase = fullCard(cv::Rect(75,201,160,160));
-//#ifdef QT_DEBUG
-//        cv::imshow(code.toStdString(), srcBase);
-//#endif
-    }
-    return getHist(srcBase);
+    HistJob histJob = newHistJob(code);
+    cv::MatND hist;
+    if(histCache.find(histJob.key, histJob.mtime, hist))    return hist;
+
+    hist = computeHistJob(histJob).hist;
+    if(!hist.empty())   histCache.insert(histJob.key, histJob.mtime, hist);
+    return hist;
 }
 
 
 cv::MatND DraftHandler::getHist(cv::Mat &srcBase)
 {
     cv::Mat hsvBase;
+    cv::MatND histBase;
+    getHist(srcBase, hsvBase, histBase);
+    return histBase;
+}
+
 
+//hsvBase y histBase se reutilizan si ya tienen el tamano adecuado.
+void DraftHandler::getHist(const cv::Mat &srcBase, cv::Mat &hsvBase, cv::MatND &histBase)
+{
     /// Convert to HSV
     cvtColor( srcBase, hsvBase, cv::COLOR_BGR2HSV );
 
     /// Using 50 bins for hue and 60 for saturation
-    int h_bins = 50; int s_bins = 60;
+    int h_bins = HIST_H_BINS; int s_bins = HIST_S_BINS;
     int histSize[] = { h_bins, s_bins };
 
     // hue varies from 0 to 179, saturation from 0 to 255
@@ -1365,11 +1748,8 @@ cv::MatND DraftHandler::getHist(cv::Mat &srcBase)
     int channels[] = { 0, 1 };
 
     /// Calculate the histograms for the HSV images
-    cv::MatND histBase;
     calcHist( &hsvBase, 1, channels, cv::Mat(), histBase, 2, histSize, ranges, true, false );
     normalize( histBase, histBase, 0, 1, cv::NORM_MINMAX, -1, cv::Mat() );
-
-    return histBase;
 }
 
 
@@ -1382,44 +1762,78 @@ bool DraftHandler::screenFound()
 
 void DraftHandler::startFindScreenRects()
 {
-    if(!futureFindScreenRects.isRunning() &&
-            (drafting || heroDrafting))  futureFindScreenRects.setFuture(QtConcurrent::run(this, &DraftHandler::findScreenRects));
+    if(futureFindScreenRects.isRunning() || (!drafting && !heroDrafting))  return;
+
+    //Buscamos en todas las pantallas a la vez, empezando por la que uso Hearthstone la ultima vez
+    QList<QScreen *> screens = QGuiApplication::screens();
+    QSettings settings("Arena Tracker", "Arena Tracker");
+    QString lastScreen = settings.value("draftScreen", "").toString();
+
+    QList<int> screenIndexes;
+    for(int i=0; i<screens.count(); i++)
+    {
+        if(screens[i] != nullptr && screens[i]->name() == lastScreen)  screenIndexes.prepend(i);
+        else                                                            screenIndexes.append(i);
+    }
+
+    futureFindScreenRects.setFuture(QtConcurrent::mapped(screenIndexes, FindScreenRects(this)));
 }
 
 
-void DraftHandler::finishFindScreenRects()
+//La primera pantalla en la que se encuentra el template cancela la busqueda en el resto.
+void DraftHandler::addScreenDetection(int index)
 {
-    ScreenDetection screenDetection = futureFindScreenRects.result();
+    if(futureFindScreenRects.isCanceled())  return;
 
-    if(screenDetection.screenIndex == -1)
-    {
-        this->screenIndex = -1;
-        emit pDebug("Hearthstone arena screen not found. Retrying...");
-        QTimer::singleShot(CAPTUREDRAFT_LOOP_FLANN_TIME, this, SLOT(startFindScreenRects()));
-    }
-    else
+    ScreenDetection screenDetection = futureFindScreenRects.resultAt(index);
+    if(screenDetection.screenIndex == -1)   return;
+
+    futureFindScreenRects.cancel();
+
+    this->screenIndex = screenDetection.screenIndex;
+    this->screenScale = screenDetection.screenScale;
+    for(int i=0; i<3; i++)
     {
-        this->screenIndex = screenDetection.screenIndex;
-        for(int i=0; i<3; i++)
-        {
-            this->screenRects[i] = screenDetection.screenRects[i];
+        this->screenRects[i] = screenDetection.screenRects[i];
 //#ifdef QT_DEBUG
-//            qDebug()<<"[" + QString::number(i) + "]"<<screenRects[i].x<<screenRects[i].y<<screenRects[i].width<<screenRects[i].height;
+//        qDebug()<<"[" + QString::number(i) + "]"<<screenRects[i].x<<screenRects[i].y<<screenRects[i].width<<screenRects[i].height;
 //#endif
-        }
-
-        emit pDebug("Hearthstone arena screen detected on screen " + QString::number(screenIndex));
+    }
 
-        createDraftWindows(screenDetection.screenScale);
-        newCaptureDraftLoop();
+    QList<QScreen *> screens = QGuiApplication::screens();
+    if(screenIndex < screens.count() && screens[screenIndex] != nullptr)
+    {
+        QSettings settings("Arena Tracker", "Arena Tracker");
+        settings.setValue("draftScreen", screens[screenIndex]->name());
     }
+
+    emit pDebug("Hearthstone arena screen detected on screen " + QString::number(screenIndex));
+
+    createDraftWindows(screenDetection.screenScale);
+    newCaptureDraftLoop();
 }
 
 
-ScreenDetection DraftHandler::findScreenRects()
+void DraftHandler::finishFindScreenRects()
 {
-    ScreenDetection screenDetection;
+    //Cancelado por addScreenDetection al encontrar la pantalla
+    if(futureFindScreenRects.isCanceled())  return;
+
+    this->screenIndex = -1;
+    emit pDebug("Hearthstone arena screen not found. Retrying...");
+    QTimer::singleShot(CAPTUREDRAFT_LOOP_FLANN_TIME, this, SLOT(startFindScreenRects()));
+}
 
+
+ScreenDetection FindScreenRects::operator()(int screenIndex) const
+{
+    return draftHandler->findScreenRects(screenIndex);
+}
+
+
+//Esquinas de las 3 cartas en arenaTemplate.png (drafting) o heroesTemplate.png
+std::vector<Point2f> DraftHandler::getTemplatePoints(bool drafting)
+{
     std::vector<Point2f> templatePoints(6);
     if(drafting)
     {
@@ -1433,29 +1847,31 @@ ScreenDetection DraftHandler::findScreenRects()
         templatePoints[2] = cvPoint(453,332); templatePoints[3] = cvPoint(453+152,332+152);
         templatePoints[4] = cvPoint(724,332); templatePoints[5] = cvPoint(724+152,332+152);
     }
+    return templatePoints;
+}
 
 
+ScreenDetection DraftHandler::findScreenRects(int screenIndex)
+{
+    ScreenDetection screenDetection;
+    std::vector<Point2f> templatePoints = getTemplatePoints(drafting);
+
     QList<QScreen *> screens = QGuiApplication::screens();
-    for(int screenIndex=0; screenIndex<screens.count(); screenIndex++)
-    {
-        QScreen *screen = screens[screenIndex];
-        if (!screen)    continue;
+    if(screenIndex < 0 || screenIndex >= screens.count())   return screenDetection;
+    QScreen *screen = screens[screenIndex];
+    if (!screen)    return screenDetection;
 
-        std::vector<Point2f> screenPoints = Utility::findTemplateOnScreen(drafting?"arenaTemplate.png":"heroesTemplate.png", screen,
-                                                                          templatePoints, screenDetection.screenScale);
-        if(screenPoints.empty())    continue;
+    std::vector<Point2f> screenPoints = screenLocator.findTemplateOnScreen(drafting?"arenaTemplate.png":"heroesTemplate.png", screen,
+                                                                           templatePoints, screenDetection.screenScale);
+    if(screenPoints.empty())    return screenDetection;
 
-        //Calculamos screenRect
-        for(int i=0; i<3; i++)
-        {
-            screenDetection.screenRects[i]=cv::Rect(screenPoints[static_cast<ulong>(i*2)], screenPoints[static_cast<ulong>(i*2+1)]);
-        }
-
-        screenDetection.screenIndex = screenIndex;
-        return screenDetection;
+    //Calculamos screenRect
+    for(int i=0; i<3; i++)
+    {
+        screenDetection.screenRects[i]=cv::Rect(screenPoints[static_cast<ulong>(i*2)], screenPoints[static_cast<ulong>(i*2+1)]);
     }
 
-    screenDetection.screenIndex = -1;
+    screenDetection.screenIndex = screenIndex;
     return screenDetection;
 }
 
@@ -1883,6 +2299,13 @@ bool DraftHandler::isDrafting()
 }
 
 
+//Las synergyFlags dependen de cards.json
+void DraftHandler::clearSynergyFlags()
+{
+    if(synergyHandler != nullptr)   synergyHandler->clearSynergyFlags();
+}
+
+
 void DraftHandler::setNormalizedLF(bool value)
 {
     this->normalizedLF = value;
@@ -10,8 +10,12 @@
 #include "Widgets/draftmechanicswindow.h"
 #include "synergyhandler.h"
 #include "twitchhandler.h"
+#include "Utils/histcache.h"
+#include "Utils/histmatcher.h"
+#include "Utils/screenlocator.h"
 #include <QObject>
 #include <QFutureWatcher>
+#include <QSet>
 
 
 #define CAPTUREDRAFT_START_TIME         1500
@@ -23,6 +27,15 @@
 #define CARD_ACCEPTED_THRESHOLD_INCREASE    0.02
 #define CAPTURE_MIN_CANDIDATES                 7
 #define CAPTURE_EXTENDED_CANDIDATES            15
+#define CAPTURE_THUMB_SIZE                     32
+#define CAPTURE_DIFF_THRESHOLD                 2.0
+#define CLASS_POOL_THRESHOLD                   CARD_ACCEPTED_THRESHOLD
+#define CAPTURE_RARITY_FRAMES                  3
+
+//Grupos de rareza en HistMatcher, ordenados para que legendarias+otras y otras+no legendarias sean rangos contiguos
+#define RARITY_GROUP_LEGENDARY      0
+#define RARITY_GROUP_OTHER          1   //No coleccionables/sin rareza, siempre se comparan
+#define RARITY_GROUP_NON_LEGENDARY  2
 
 
 class LFtier
@@ -40,9 +53,37 @@ public:
     QPointF screenScale = QPointF(0,0);
 };
 
+//Histograma de una imagen de carta pendiente de calcular en el thread pool.
+class HistJob
+{
+public:
+    QString code;       //Code(_premium)
+    QString key;        //Clave en histCache
+    QString filePath;
+    qint64 mtime = 0;
+    bool drafting = true;
+    cv::MatND hist;
+};
+
+class DraftHandler;
+
+//Funtor para QtConcurrent::mapped, busca la pantalla de arena en un QScreen.
+class FindScreenRects
+{
+public:
+    typedef ScreenDetection result_type;
+    FindScreenRects(DraftHandler *draftHandler) : draftHandler(draftHandler) {}
+    ScreenDetection operator()(int screenIndex) const;
+
+private:
+    DraftHandler *draftHandler;
+};
+
 class DraftHandler : public QObject
 {
     Q_OBJECT
+    friend class FindScreenRects;
+    friend class CaptureBenchmark;
 public:
     DraftHandler(QObject *parent, Ui::Extended *ui);
     ~DraftHandler();
@@ -57,6 +98,17 @@ private:
     QMap<QString, int> hearthArenaTiers;
     QMap<QString, LFtier> lightForgeTiers;
     QMap<QString, cv::MatND> cardsHist;
+    HistCache histCache;
+    HistMatcher histMatcher;
+    QSet<QString> classCodes;           //Cartas de la clase del heroe + neutrales (sin _premium)
+    HistMatcher classHistMatcher;       //Solo si classCodes es menor que el pool completo (multiclass)
+    bool fullPoolCapture;               //Este pick ha pasado a buscar en el pool completo
+    CardRarity captureRarity;           //LEGENDARY/COMMON(no legendaria) deducida en este pick, INVALID_RARITY sin filtrar
+    CardRarity captureRarityCandidate;  //Rareza en la que coinciden las 3 cartas, pendiente de CAPTURE_RARITY_FRAMES
+    int captureRarityFrames;
+    QList<HistJob> histJobs;            //Primero las de classCodes, para empezar a capturar con classHistMatcher
+    int classHistJobsLeft, otherHistJobsLeft;
+    QFutureWatcher<HistJob> futureHists;
     QStringList cardsDownloading;
     DraftCard draftCards[3];
     //Guarda los mejores candidatos de esta iteracion
@@ -68,6 +120,12 @@ private:
     int deckRatingHA, deckRatingLF;
     cv::Rect screenRects[3];
     int screenIndex;
+    QPointF screenScale;
+    cv::Mat captureHsv[3];      //Buffers reutilizados en cada iteracion de captureDraft
+    cv::MatND captureHist[3];
+    cv::Mat captureThumbs[3];   //Miniaturas de la captura anterior para detectar si la pantalla ha cambiado
+    cv::Mat captureDistances;   //Distancias del ultimo match, se reutilizan mientras la pantalla no cambie
+                                //y se vacian al cambiar captureMatcher(), fullPoolCapture o captureRarity
     int numCaptured;
     bool drafting, heroDrafting, capturing, leavingArena;
     bool mouseInApp;
@@ -80,6 +138,7 @@ private:
     QString justPickedCard; //Evita doble pick card en Arena.log
     DraftMethod draftMethod;
     QFutureWatcher<ScreenDetection> futureFindScreenRects;
+    ScreenLocator screenLocator;    //Solo se usa desde findScreenRects (una pantalla por thread)
     QLabel *labelLFscore[3];
     QLabel *labelHAscore[3];
     QComboBox *comboBoxCard[3];
@@ -96,15 +155,25 @@ private:
 private:
     void completeUI();
     cv::MatND getHist(const QString &code);
-    cv::MatND getHist(cv::Mat &srcBase);
+    static cv::MatND getHist(cv::Mat &srcBase);
+    static void getHist(const cv::Mat &srcBase, cv::Mat &hsvBase, cv::MatND &histBase);
+    HistJob newHistJob(const QString &code);
+    static HistJob computeHistJob(const HistJob &histJob);
+    void startHistJobs();
+    void cancelHistJobs();
+    void checkCardsHistReady();
+    void checkClassHistReady();
+    bool isCaptureMatcherReady() const;
     void initCodesAndHistMaps(QString hero="");
     void resetTab(bool alreadyDrafting);
     void clearLists(bool keepCounters);
-    bool getScreenCardsHist(cv::MatND screenCardsHist[3]);
+    bool getScreenCardsHist(cv::MatND screenCardsHist[3], bool &screenChanged);
+    bool updateCaptureThumbs(cv::Mat bigCards[3]);
     void showNewCards(DraftCard bestCards[]);
     void updateDeckScore(float cardRatingHA=0, float cardRatingLF=0);
     bool screenFound();
-    ScreenDetection findScreenRects();
+    ScreenDetection findScreenRects(int screenIndex);
+    static std::vector<Point2f> getTemplatePoints(bool drafting);
     void clearScore(QLabel *label, DraftMethod draftMethod, bool clearText=true);
     void highlightScore(QLabel *label, DraftMethod draftMethod);
     void deleteDraftHeroWindow();
@@ -116,14 +185,23 @@ private:
     void initHearthArenaTiers(const QString &heroString, const bool multiClassDraft);
     QMap<QString, LFtier> initLightForgeTiers(const QString &heroString, const bool multiClassDraft);
     void createDraftWindows(const QPointF &screenScale);
-    void mapBestMatchingCodes(cv::MatND screenCardsHist[]);
-    double getMinMatch(const QMap<QString, DraftCard> &draftCardMaps);
-    bool areCardsDetected();
+    void matchCaptureHist(cv::MatND hists[3], cv::Mat &distances);
+    void updateFullPoolCapture(cv::MatND hists[3], cv::Mat &distances);
+    static bool isClassPoolConfident(const cv::Mat &distances);
+    static void matchRarityRange(const HistMatcher &matcher, CardRarity rarity, cv::MatND hists[3], cv::Mat &distances);
+    void updateCaptureRarity();
+    static CardRarity getPickRarity(QMap<QString, DraftCard> draftCardMaps[3]);
+    static QHash<QString, int> getRarityGroups(const QMap<QString, cv::MatND> &hists);
+    const HistMatcher & captureMatcher() const;
+    static void mapBestMatchingCodes(const HistMatcher &matcher, const cv::Mat &distances,
+                                     QMap<QString, DraftCard> draftCardMaps[3], int &numCaptured, int numCandidates);
+    static double getMinMatch(const QMap<QString, DraftCard> &draftCardMaps);
+    static bool areCardsDetected(QMap<QString, DraftCard> draftCardMaps[3], bool cardDetected[3], int numCaptured);
     void buildBestMatchesMaps();
     CardRarity getBestRarity();
     void getBestCards(DraftCard bestCards[3]);
     void addCardHist(QString code, bool premium, bool isHero=false);
-    QString degoldCode(QString fileName);
+    static QString degoldCode(QString fileName);
     void createScoreItems();
     void createSynergyHandler();
     bool isGoldCode(QString fileName);
@@ -199,10 +277,14 @@ public slots:
     void setPremium(bool premium);
     void setNormalizedLF(bool value);
     void updateMinimumHeight();
+    void clearSynergyFlags();
 
 private slots:
     void captureDraft();
+    void addScreenDetection(int index);
     void finishFindScreenRects();
+    void addComputedHist(int index);
+    void finishHistJobs();
     void startFindScreenRects();
     void comboBoxChanged();
     void refreshCapturedCards();
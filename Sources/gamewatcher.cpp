@@ -15,11 +15,113 @@ GameWatcher::~GameWatcher()
 }
 
 
+/*
+ * Los patrones se compilan una sola vez para todo el proceso. optimize() fuerza la
+ * compilacion (y el JIT de PCRE si esta disponible) para no pagarla en la primera linea.
+ */
+QVector<QRegularExpression> GameWatcher::initPatterns()
+{
+    QVector<QRegularExpression> patterns(numLogPatterns);
+
+    //LoadingScreen
+    patterns[lsSceneLoaded] = QRegularExpression("LoadingScreen\\.OnSceneLoaded\\(\\) *- *prevMode=(\\w+) *currMode=(\\w+)");
+
+    //Arena
+    patterns[arOnChosen] = QRegularExpression("DraftManager\\.OnChosen\\(\\): hero=HERO_(\\d+)");
+    patterns[arClientChooses] = QRegularExpression("Client chooses: .* \\((\\w+)\\)");
+    patterns[arDeckHeroRead] = QRegularExpression("DraftManager\\.OnChoicesAndContents - Draft Deck ID: \\d+, Hero Card = HERO_\\d+");
+    patterns[arDeckCard] = QRegularExpression("DraftManager\\.OnChoicesAndContents - Draft deck contains card (\\w+)");
+    patterns[arNewDeck] = QRegularExpression("DraftManager\\.OnBegin - Got new draft deck with ID: \\d+");
+    patterns[arChoosingHero] = QRegularExpression("DraftManager\\.OnChoicesAndContents - Draft Deck ID: \\d+, Hero Card =");
+
+    //Power
+    patterns[pwWon] = QRegularExpression(
+        "PowerTaskList\\.DebugPrintPower\\(\\) - *TAG_CHANGE "
+        "Entity=(.+) tag=PLAYSTATE value=(WON|TIED)");
+    patterns[pwTurn] = QRegularExpression(
+        "PowerTaskList\\.DebugPrintPower\\(\\) - *TAG_CHANGE "
+        "Entity=GameEntity tag=TURN value=(\\d+)");
+
+    //Power - heroType1State/heroType2State
+    patterns[phCreatingHero] = QRegularExpression("Creating ID=\\d+ CardID=HERO_(\\d+)");
+    patterns[phPlayerId] = QRegularExpression("Player EntityID=\\d+ PlayerID=(\\d+) GameAccountId=");
+    patterns[phWhizbangDeck] = QRegularExpression("tag=WHIZBANG_DECK_ID value=(\\d+)");
+
+    //Power - mulliganState
+    patterns[pmEntityChoices] = QRegularExpression("GameState\\.DebugPrintEntityChoices\\(\\) - id=(\\d+) Player=(.*) TaskList=\\d+ ChoiceType=MULLIGAN CountMin=0 CountMax=(\\d+)");
+    patterns[pmMulliganDone] = QRegularExpression("Entity=(.+) tag=MULLIGAN_STATE value=DONE");
+    patterns[pmCoinEntity] = QRegularExpression(
+        "GameState\\.DebugPrintEntityChoices\\(\\) - *"
+        "Entities\\[4\\]=\\[entityName=.* id=(\\d+) zone=HAND zonePos=5 cardId=.* player=\\d+\\]");
+
+    //Power - inGameState
+    patterns[pgShowTag] = QRegularExpression(
+        "PowerTaskList\\.DebugPrintPower\\(\\) - *"
+        "tag=(\\w+) value=(\\w+)");
+    patterns[pgTagChangePlayer] = QRegularExpression(
+        "PowerTaskList\\.DebugPrintPower\\(\\) - *TAG_CHANGE "
+        "Entity=(.*) tag=(\\w+) value=(\\w+)");
+    patterns[pgTagChangeUnknown] = QRegularExpression(
+        "PowerTaskList\\.DebugPrintPower\\(\\) - *TAG_CHANGE "
+        "Entity=\\[entityName=UNKNOWN ENTITY \\[cardType=INVALID\\] id=(\\d+) zone=\\w+ zonePos=\\d+ cardId= player=(\\d+)\\] "
+        "tag=(\\w+) value=(\\w+)");
+    patterns[pgTagChangeKnown] = QRegularExpression(
+        "PowerTaskList\\.DebugPrintPower\\(\\) - *TAG_CHANGE "
+        "Entity=\\[entityName=(.*) id=(\\d+) zone=(\\w+) zonePos=\\d+ cardId=(\\w*) player=(\\d+)\\] "
+        "tag=(\\w+) value=(\\w+)");
+    patterns[pgBlockUnknown] = QRegularExpression(
+        "PowerTaskList\\.DebugPrintPower\\(\\) - BLOCK_START BlockType=(\\w+) "
+        "Entity=\\[entityName=UNKNOWN ENTITY \\[cardType=INVALID\\] id=(\\d+) zone=\\w+ zonePos=\\d+ cardId= player=\\d+\\] "
+        "EffectCardId=\\w* EffectIndex=-?\\d+ "
+        "Target=");
+    patterns[pgShowEntityKnown] = QRegularExpression(
+        "PowerTaskList\\.DebugPrintPower\\(\\) - *SHOW_ENTITY - Updating "
+        "Entity=\\[entityName=.* id=(\\d+) zone=\\w+ zonePos=\\d+ cardId=\\w* player=(\\d+)\\] "
+        "CardID=\\w+");
+    patterns[pgShowEntityUnknown] = QRegularExpression(
+        "PowerTaskList\\.DebugPrintPower\\(\\) - *SHOW_ENTITY - Updating "
+        "Entity=\\[entityName=UNKNOWN ENTITY \\[cardType=INVALID\\] id=(\\d+) zone=\\w+ zonePos=\\d+ cardId= player=(\\d+)\\] "
+        "CardID=\\w+");
+    patterns[pgFullEntity] = QRegularExpression(
+        "PowerTaskList\\.DebugPrintPower\\(\\) - *FULL_ENTITY - Updating "
+        "\\[entityName=.* id=(\\d+) zone=\\w+ zonePos=\\d+ cardId=\\w* player=(\\d+)\\] "
+        "CardID=\\w+");
+    patterns[pgChangeEntity] = QRegularExpression(
+        "PowerTaskList\\.DebugPrintPower\\(\\) - *CHANGE_ENTITY - Updating Entity="
+        "\\[entityName=.* id=(\\d+) zone=(\\w+) zonePos=\\d+ cardId=\\w* player=(\\d+)\\] "
+        "CardID=(\\w+)");
+    patterns[pgBlock] = QRegularExpression(
+        "PowerTaskList\\.DebugPrintPower\\(\\) - BLOCK_START BlockType=(\\w+) "
+        "Entity=\\[entityName=(.*) id=(\\d+) zone=(\\w+) zonePos=\\d+ cardId=(\\w+) player=(\\d+)\\] "
+        "EffectCardId=\\w* EffectIndex=-?\\d+ "
+        "Target=(?:\\[entityName=(.*) id=(\\d+) zone=(\\w+) zonePos=\\d+ cardId=(\\w+) player=\\d+\\])?");
+
+    //Zone
+    patterns[znUnknownCard] = QRegularExpression(
+        "\\[entityName=UNKNOWN ENTITY \\[cardType=INVALID\\] id=(\\d+) zone=\\w+ zonePos=\\d+ cardId= player=\\d+\\] zone from "
+        "(\\w+ \\w+(?: \\(Weapon\\))?)? -> (\\w+ \\w+(?: \\((?:Weapon|Hero|Hero Power)\\))?)?");
+    patterns[znKnownCard] = QRegularExpression(
+        "\\[entityName=(.*) id=(\\d+) zone=\\w+ zonePos=(\\d+) cardId=(\\w*) player=(\\d+)\\] zone from "
+        "(\\w+ \\w+(?: \\(Weapon\\))?)? -> (\\w+ \\w+(?: \\((?:Weapon|Hero|Hero Power)\\))?)?");
+    patterns[znPosChange] = QRegularExpression("\\[entityName=(.*) id=(\\d+) zone=(?:HAND|PLAY) zonePos=\\d+ cardId=\\w+ player=(\\d+)\\] pos from \\d+ -> (\\d+)");
+
+    for(int i=0; i<numLogPatterns; i++)     patterns[i].optimize();
+    return patterns;
+}
+
+
+const QRegularExpression &GameWatcher::pattern(LogPattern logPattern)
+{
+    static const QVector<QRegularExpression> patterns = initPatterns();
+    return patterns[logPattern];
+}
+
+
 void GameWatcher::reset()
 {
     powerState = noGame;
     arenaState = noDeckRead;
-    loadingScreenState = menu;
+    setLoadingScreen(menu);
     mulliganEnemyDone = mulliganPlayerDone = false;
     turn = turnReal = 0;
     spectating = false;
@@ -60,7 +162,7 @@ void GameWatcher::processLogLine(LogComponent logComponent, QString line, qint64
 void GameWatcher::startReadingDeck()
 {
     if(arenaState == deckRead) return;
-    emit needResetDeck();    //resetDeck
+    emit needResetDeck();    //resetDeck (queued, GUI thread)
     arenaState = readingDeck;
     emit pDebug("Start reading deck (arenaState = readingDeck).", 0);
 }
@@ -94,7 +196,7 @@ void GameWatcher::setDeckRead(bool value)
 void GameWatcher::processLoadingScreen(QString &line, qint64 numLine)
 {
     //[LoadingScreen] LoadingScreen.OnSceneLoaded() - prevMode=HUB currMode=DRAFT
-    if(line.contains(QRegularExpression("LoadingScreen\\.OnSceneLoaded\\(\\) *- *prevMode=(\\w+) *currMode=(\\w+)"), match))
+    if(line.contains(pattern(lsSceneLoaded), match))
     {
         QString prevMode = match->captured(1);
         QString currMode = match->captured(2);
@@ -117,7 +219,7 @@ void GameWatcher::processLoadingScreen(QString &line, qint64 numLine)
 
         if(currMode == "DRAFT")
         {
-            loadingScreenState = arena;
+            setLoadingScreen(arena);
             emit pDebug("Entering ARENA (loadingScreenState = arena).", numLine);
 
             if(prevMode == "HUB" || prevMode == "FRIENDLY")
@@ -127,7 +229,7 @@ void GameWatcher::processLoadingScreen(QString &line, qint64 numLine)
         }
         else if(currMode == "HUB")
         {
-            loadingScreenState = menu;
+            setLoadingScreen(menu);
             emit pDebug("Entering MENU (loadingScreenState = menu).", numLine);
 
             if(prevMode == "DRAFT")
@@ -138,22 +240,22 @@ void GameWatcher::processLoadingScreen(QString &line, qint64 numLine)
         }
         else if(currMode == "TOURNAMENT")
         {
-            loadingScreenState = casual;
+            setLoadingScreen(casual);
             emit pDebug("Entering CASUAL/RANKED (loadingScreenState = casual).", numLine);
         }
         else if(currMode == "ADVENTURE")
         {
-            loadingScreenState = adventure;
+            setLoadingScreen(adventure);
             emit pDebug("Entering ADVENTURE (loadingScreenState = adventure).", numLine);
         }
         else if(currMode == "TAVERN_BRAWL")
         {
-            loadingScreenState = tavernBrawl;
+            setLoadingScreen(tavernBrawl);
             emit pDebug("Entering TAVERN (loadingScreenState = tavernBrawl).", numLine);
         }
         else if(currMode == "FRIENDLY")
         {
-            loadingScreenState = friendly;
+            setLoadingScreen(friendly);
             emit pDebug("Entering FRIENDLY (loadingScreenState = friendly).", numLine);
 
             if(prevMode == "DRAFT")
@@ -174,7 +276,7 @@ void GameWatcher::processAsset(QString &line, qint64 numLine)
     //acabamos de encontrar el WON pero aun no hemos createResult
     if(loadingScreenState == casual && logSeekWon != -1 && line.contains("assetPath=rank_window"))
     {
-        loadingScreenState = ranked;
+        setLoadingScreen(ranked);
         emit pDebug("On RANKED (loadingScreenState = ranked).", numLine);
     }
 }
@@ -190,16 +292,17 @@ void GameWatcher::processArena(QString &line, qint64 numLine)
 {
     //NEW ARENA - START DRAFT
     //[Arena] DraftManager.OnChosen(): hero=HERO_02 premium=STANDARD
-    if(line.contains(QRegularExpression("DraftManager\\.OnChosen\\(\\): hero=HERO_(\\d+)"), match))
+    if(line.contains(pattern(arOnChosen), match))
     {
         QString hero = match->captured(1);
         emit pDebug("New arena. Heroe: " + hero, numLine);
         emit pLog(tr("Log: New arena."));
-        emit newArena(hero); //(sync)Begin draft //(sync)resetDeckDontRead (arenaState = deckRead)
+        setDeckRead();
+        emit newArena(hero); //Begin draft //resetDeck
     }
     //DRAFTING PICK CARD
     //[Arena] Client chooses: Profesora violeta (NEW1_026)
-    else if(line.contains(QRegularExpression("Client chooses: .* \\((\\w+)\\)"), match))
+    else if(line.contains(pattern(arClientChooses), match))
     {
         QString code = match->captured(1);
         if(!code.contains("HERO"))
@@ -210,8 +313,7 @@ void GameWatcher::processArena(QString &line, qint64 numLine)
     }
     //START READING DECK
     //[Arena] DraftManager.OnChoicesAndContents - Draft Deck ID: 472720132, Hero Card = HERO_02
-    else if(line.contains(QRegularExpression(
-                "DraftManager\\.OnChoicesAndContents - Draft Deck ID: \\d+, Hero Card = HERO_\\d+"), match))
+    else if(line.contains(pattern(arDeckHeroRead), match))
     {
         emit pDebug("Found DraftManager.OnChoicesAndContents", numLine);
         startReadingDeck();
@@ -226,18 +328,15 @@ void GameWatcher::processArena(QString &line, qint64 numLine)
     }
     //READ DECK CARD
     //[Arena] DraftManager.OnChoicesAndContents - Draft deck contains card FP1_012
-    else if((arenaState == readingDeck) && line.contains(QRegularExpression(
-            "DraftManager\\.OnChoicesAndContents - Draft deck contains card (\\w+)"), match))
+    else if((arenaState == readingDeck) && line.contains(pattern(arDeckCard), match))
     {
         QString code = match->captured(1);
         emit pDebug("Reading deck: " + code, numLine);
         emit newDeckCard(code);
     }
     //COMPRAR ARENA -- VUELTA A SELECCION HEROE
-    else if(line.contains(QRegularExpression(
-                "DraftManager\\.OnBegin - Got new draft deck with ID: \\d+"), match) ||
-            line.contains(QRegularExpression(
-                            "DraftManager\\.OnChoicesAndContents - Draft Deck ID: \\d+, Hero Card ="), match))
+    else if(line.contains(pattern(arNewDeck), match) ||
+            line.contains(pattern(arChoosingHero), match))
     {
         emit pDebug("New arena: choosing heroe.", numLine);
         emit arenaChoosingHeroe();
@@ -338,9 +437,7 @@ void GameWatcher::processPower(QString &line, qint64 numLine, qint64 logSeek)
     {
         //Win state
         //PowerTaskList.DebugPrintPower() -     TAG_CHANGE Entity=El tabernero tag=PLAYSTATE value=WON
-        if(line.contains(QRegularExpression(
-                            "PowerTaskList\\.DebugPrintPower\\(\\) - *TAG_CHANGE "
-                            "Entity=(.+) tag=PLAYSTATE value=(WON|TIED)"), match))
+        if(line.contains(QLatin1String("tag=PLAYSTATE")) && line.contains(pattern(pwWon), match))
         {
             winnerPlayer = match->captured(1);
             tied = (match->captured(2) == "TIED");
@@ -354,10 +451,7 @@ void GameWatcher::processPower(QString &line, qint64 numLine, qint64 logSeek)
         }
         //Turn
         //PowerTaskList.DebugPrintPower() -     TAG_CHANGE Entity=GameEntity tag=TURN value=12
-        else if(line.contains(QRegularExpression(
-                            "PowerTaskList\\.DebugPrintPower\\(\\) - *TAG_CHANGE "
-                            "Entity=GameEntity tag=TURN value=(\\d+)"
-                ), match))
+        else if(line.contains(QLatin1String("tag=TURN value=")) && line.contains(pattern(pwTurn), match))
         {
             turn = match->captured(1).toInt();
             emit logTurn();
@@ -391,7 +485,7 @@ void GameWatcher::processPower(QString &line, qint64 numLine, qint64 logSeek)
 
 void GameWatcher::processPowerHero(QString &line, qint64 numLine)
 {
-    if(line.contains(QRegularExpression("Creating ID=\\d+ CardID=HERO_(\\d+)"), match))
+    if(line.contains(pattern(phCreatingHero), match))
     {
         if(powerState == heroType1State)
         {
@@ -422,13 +516,13 @@ void GameWatcher::processPowerHero(QString &line, qint64 numLine)
     }
 
     //Whizbang support
-    else if(line.contains(QRegularExpression("Player EntityID=\\d+ PlayerID=(\\d+) GameAccountId="), match))
+    else if(line.contains(pattern(phPlayerId), match))
     {
         whizbangPlayerID = match->captured(1);
 //        emit pDebug("Found whizbandPlayerID: " + whizbangPlayerID, numLine);
     }
     else if(!whizbangPlayerID.isEmpty() &&
-            line.contains(QRegularExpression("tag=WHIZBANG_DECK_ID value=(\\d+)"), match))
+            line.contains(pattern(phWhizbangDeck), match))
     {
         if(whizbangPlayerID == "1") {
             whizbangDeckCode1 = match->captured(1);
@@ -449,9 +543,7 @@ void GameWatcher::processPowerMulligan(QString &line, qint64 numLine)
     //Jugador/Enemigo names, playerTag y firstPlayer
     //GameState.DebugPrintEntityChoices() - id=1 Player=fayatime TaskList=3 ChoiceType=MULLIGAN CountMin=0 CountMax=5
     //GameState.DebugPrintEntityChoices() - id=2 Player=Винсент TaskList=4 ChoiceType=MULLIGAN CountMin=0 CountMax=3
-    if(line.contains(QRegularExpression(
-                "GameState\\.DebugPrintEntityChoices\\(\\) - id=(\\d+) Player=(.*) TaskList=\\d+ ChoiceType=MULLIGAN CountMin=0 CountMax=(\\d+)"
-                  ), match))
+    if(line.contains(pattern(pmEntityChoices), match))
     {
         QString player = match->captured(1);
         QString playerName = match->captured(2);
@@ -487,8 +579,7 @@ void GameWatcher::processPowerMulligan(QString &line, qint64 numLine)
     //MULLIGAN DONE
     //GameState.DebugPrintPower() -     TAG_CHANGE Entity=fayatime tag=MULLIGAN_STATE value=DONE
     //GameState.DebugPrintPower() -     TAG_CHANGE Entity=Винсент tag=MULLIGAN_STATE value=DONE
-    else if(line.contains(QRegularExpression("Entity=(.+) tag=MULLIGAN_STATE value=DONE"
-            ), match))
+    else if(line.contains(pattern(pmMulliganDone), match))
     {
         //Player mulligan
         if(match->captured(1) == playerTag)
@@ -536,10 +627,7 @@ void GameWatcher::processPowerMulligan(QString &line, qint64 numLine)
 
     //GameState.DebugPrintEntityChoices() -   Entities[4]=[entityName=La moneda id=68 zone=HAND zonePos=5 cardId=GAME_005 player=2]
     //GameState.DebugPrintEntityChoices() -   Entities[4]=[entityName=UNKNOWN ENTITY [cardType=INVALID] id=68 zone=HAND zonePos=5 cardId= player=1]
-    else if(line.contains(QRegularExpression(
-                "GameState\\.DebugPrintEntityChoices\\(\\) - *"
-                "Entities\\[4\\]=\\[entityName=.* id=(\\d+) zone=HAND zonePos=5 cardId=.* player=\\d+\\]"
-                  ), match))
+    else if(line.contains(pattern(pmCoinEntity), match))
     {
         QString id = match->captured(1);
         emit pDebug("Coin ID: " + id, numLine);
@@ -550,12 +638,18 @@ void GameWatcher::processPowerMulligan(QString &line, qint64 numLine)
 
 void GameWatcher::processPowerInGame(QString &line, qint64 numLine)
 {
+    //Prefiltro literal: todos los patrones inGame son de PowerTaskList,
+    //el resto de lineas (GameState...) solo reinician lastShowEntity. LogWorker sustituye las lineas
+    //que descarta (PowerProcessor, Options) por su timeStamp, que tambien llega aqui y reinicia lastShowEntity.
+    if(!line.contains(QLatin1String("PowerTaskList.DebugPrintPower()")))
+    {
+        lastShowEntity.id = -1;
+        return;
+    }
+
     //SHOW_ENTITY tag
     //tag=HEALTH value=1
-    if(line.contains(QRegularExpression(
-        "PowerTaskList\\.DebugPrintPower\\(\\) - *"
-        "tag=(\\w+) value=(\\w+)"
-        ), match))
+    if(line.contains(pattern(pgShowTag), match))
     {
         QString tag = match->captured(1);
         QString value = match->captured(2);
@@ -583,10 +677,7 @@ void GameWatcher::processPowerInGame(QString &line, qint64 numLine)
 
         //TAG_CHANGE jugadores conocido
         //D 10:48:46.1127070 PowerTaskList.DebugPrintPower() -     TAG_CHANGE Entity=SerKolobok tag=RESOURCES value=3
-        if(line.contains(QRegularExpression(
-            "PowerTaskList\\.DebugPrintPower\\(\\) - *TAG_CHANGE "
-            "Entity=(.*) tag=(\\w+) value=(\\w+)"
-            ), match))
+        if(line.contains(QLatin1String("TAG_CHANGE")) && line.contains(pattern(pgTagChangePlayer), match))
         {
             QString name = match->captured(1);
             QString tag = match->captured(2);
@@ -613,11 +704,7 @@ void GameWatcher::processPowerInGame(QString &line, qint64 numLine)
         //TAG_CHANGE desconocido
         //TAG_CHANGE Entity=[entityName=UNKNOWN ENTITY [cardType=INVALID] id=49 zone=HAND zonePos=3 cardId= player=2] tag=CLASS value=MAGE
         //TAG_CHANGE Entity=[entityName=UNKNOWN ENTITY [cardType=INVALID] id=37 zone=HAND zonePos=2 cardId= player=2] tag=CLASS value=MAGE
-        if(line.contains(QRegularExpression(
-            "PowerTaskList\\.DebugPrintPower\\(\\) - *TAG_CHANGE "
-            "Entity=\\[entityName=UNKNOWN ENTITY \\[cardType=INVALID\\] id=(\\d+) zone=\\w+ zonePos=\\d+ cardId= player=(\\d+)\\] "
-            "tag=(\\w+) value=(\\w+)"
-            ), match))
+        if(line.contains(QLatin1String("TAG_CHANGE")) && line.contains(pattern(pgTagChangeUnknown), match))
         {
             QString id = match->captured(1);
             QString player = match->captured(2);
@@ -661,11 +748,7 @@ void GameWatcher::processPowerInGame(QString &line, qint64 numLine)
         //PowerTaskList aparece segundo pero hay acciones que no tienen GameState, como el damage del maestro del acero herido
         //GameState.DebugPrintPower() -         TAG_CHANGE Entity=[entityName=Déspota del templo id=36 zone=PLAY zonePos=1 cardId=EX1_623 player=2] tag=DAMAGE value=0
         //GameState.DebugPrintPower() -     TAG_CHANGE Entity=[entityName=Déspota del templo id=36 zone=PLAY zonePos=1 cardId=EX1_623 player=2] tag=ATK value=3
-        else if(line.contains(QRegularExpression(
-            "PowerTaskList\\.DebugPrintPower\\(\\) - *TAG_CHANGE "
-            "Entity=\\[entityName=(.*) id=(\\d+) zone=(\\w+) zonePos=\\d+ cardId=(\\w*) player=(\\d+)\\] "
-            "tag=(\\w+) value=(\\w+)"
-            ), match))
+        else if(line.contains(QLatin1String("TAG_CHANGE")) && line.contains(pattern(pgTagChangeKnown), match))
         {
             QString name = match->captured(1);
             QString id = match->captured(2);
@@ -697,12 +780,7 @@ void GameWatcher::processPowerInGame(QString &line, qint64 numLine)
         //Enemigo accion desconocida
         //BLOCK_START BlockType=PLAY Entity=[entityName=UNKNOWN ENTITY [cardType=INVALID] id=49 zone=HAND zonePos=3 cardId= player=2]
         //EffectCardId= EffectIndex=0 Target=0
-        else if(line.contains(QRegularExpression(
-            "PowerTaskList\\.DebugPrintPower\\(\\) - BLOCK_START BlockType=(\\w+) "
-            "Entity=\\[entityName=UNKNOWN ENTITY \\[cardType=INVALID\\] id=(\\d+) zone=\\w+ zonePos=\\d+ cardId= player=\\d+\\] "
-            "EffectCardId=\\w* EffectIndex=-?\\d+ "
-            "Target="
-            ), match))
+        else if(line.contains(QLatin1String("BLOCK_START")) && line.contains(pattern(pgBlockUnknown), match))
         {
             QString blockType = match->captured(1);
             QString id = match->captured(2);
@@ -716,11 +794,7 @@ void GameWatcher::processPowerInGame(QString &line, qint64 numLine)
         //SHOW_ENTITY conocido
         //SHOW_ENTITY - Updating Entity=[entityName=Maestra de secta id=50 zone=DECK zonePos=0 cardId= player=2] CardID=EX1_595
         //SHOW_ENTITY - Updating Entity=[entityName=Turbocerdo con pinchos id=18 zone=DECK zonePos=0 cardId=CFM_688 player=1] CardID=CFM_688
-        else if(line.contains(QRegularExpression(
-            "PowerTaskList\\.DebugPrintPower\\(\\) - *SHOW_ENTITY - Updating "
-            "Entity=\\[entityName=.* id=(\\d+) zone=\\w+ zonePos=\\d+ cardId=\\w* player=(\\d+)\\] "
-            "CardID=\\w+"
-            ), match))
+        else if(line.contains(QLatin1String("SHOW_ENTITY")) && line.contains(pattern(pgShowEntityKnown), match))
         {
             QString id = match->captured(1);
             QString player = match->captured(2);
@@ -735,11 +809,7 @@ void GameWatcher::processPowerInGame(QString &line, qint64 numLine)
 
         //SHOW_ENTITY desconocido
         //SHOW_ENTITY - Updating Entity=[entityName=UNKNOWN ENTITY [cardType=INVALID] id=58 zone=HAND zonePos=3 cardId= player=2] CardID=EX1_011
-        else if(line.contains(QRegularExpression(
-            "PowerTaskList\\.DebugPrintPower\\(\\) - *SHOW_ENTITY - Updating "
-            "Entity=\\[entityName=UNKNOWN ENTITY \\[cardType=INVALID\\] id=(\\d+) zone=\\w+ zonePos=\\d+ cardId= player=(\\d+)\\] "
-            "CardID=\\w+"
-            ), match))
+        else if(line.contains(QLatin1String("SHOW_ENTITY")) && line.contains(pattern(pgShowEntityUnknown), match))
         {
             QString id = match->captured(1);
             QString player = match->captured(2);
@@ -754,11 +824,7 @@ void GameWatcher::processPowerInGame(QString &line, qint64 numLine)
 
         //FULL_ENTITY conocido
         //FULL_ENTITY - Updating [entityName=Recluta Mano de Plata id=95 zone=PLAY zonePos=3 cardId=CS2_101t player=2] CardID=CS2_101t
-        else if(line.contains(QRegularExpression(
-            "PowerTaskList\\.DebugPrintPower\\(\\) - *FULL_ENTITY - Updating "
-            "\\[entityName=.* id=(\\d+) zone=\\w+ zonePos=\\d+ cardId=\\w* player=(\\d+)\\] "
-            "CardID=\\w+"
-            ), match))
+        else if(line.contains(QLatin1String("FULL_ENTITY")) && line.contains(pattern(pgFullEntity), match))
         {
             QString id = match->captured(1);
             QString player = match->captured(2);
@@ -773,11 +839,7 @@ void GameWatcher::processPowerInGame(QString &line, qint64 numLine)
 
         //CHANGE_ENTITY conocido
         //CHANGE_ENTITY - Updating Entity=[entityName=Aullavísceras id=53 zone=HAND zonePos=3 cardId=EX1_411 player=2] CardID=OG_031
-        else if(line.contains(QRegularExpression(
-            "PowerTaskList\\.DebugPrintPower\\(\\) - *CHANGE_ENTITY - Updating Entity="
-            "\\[entityName=.* id=(\\d+) zone=(\\w+) zonePos=\\d+ cardId=\\w* player=(\\d+)\\] "
-            "CardID=(\\w+)"
-            ), match))
+        else if(line.contains(QLatin1String("CHANGE_ENTITY")) && line.contains(pattern(pgChangeEntity), match))
         {
             QString id = match->captured(1);
             QString zone = match->captured(2);
@@ -811,12 +873,7 @@ void GameWatcher::processPowerInGame(QString &line, qint64 numLine)
         //EffectCardId= EffectIndex=-1 Target=[entityName=Trituradora antigua de Sneed id=23 zone=PLAY zonePos=5 cardId=GVG_114 player=1]
         //PowerTaskList.DebugPrintPower() - BLOCK_START BlockType=FATIGUE Entity=[entityName=Malfurion Tempestira id=76 zone=PLAY zonePos=0 cardId=HERO_06 player=1]
         //EffectCardId= EffectIndex=0 Target=0
-        else if(line.contains(QRegularExpression(
-            "PowerTaskList\\.DebugPrintPower\\(\\) - BLOCK_START BlockType=(\\w+) "
-            "Entity=\\[entityName=(.*) id=(\\d+) zone=(\\w+) zonePos=\\d+ cardId=(\\w+) player=(\\d+)\\] "
-            "EffectCardId=\\w* EffectIndex=-?\\d+ "
-            "Target=(?:\\[entityName=(.*) id=(\\d+) zone=(\\w+) zonePos=\\d+ cardId=(\\w+) player=\\d+\\])?"
-            ), match))
+        else if(line.contains(QLatin1String("BLOCK_START")) && line.contains(pattern(pgBlock), match))
         {
             QString blockType = match->captured(1);
             QString name1 = match->captured(2);
@@ -854,8 +911,7 @@ void GameWatcher::processPowerInGame(QString &line, qint64 numLine)
                 //Jugador juega carta con objetivo en PLAY, No enemigo pq BlockType=PLAY es de entity desconocida para el enemigo
                 if(blockType == "PLAY" && zone == "HAND")
                 {
-                    DeckCard deckCard(cardId1);
-                    if(deckCard.getType() == SPELL)
+                    if(Utility::getTypeFromCode(cardId1) == SPELL)
                     {
                         emit pDebug((isPlayer?QString("Player"):QString("Enemy")) + ": Spell obj played: " +
                                     name1 + " on target " + name2, numLine);
@@ -941,13 +997,12 @@ void GameWatcher::processPowerInGame(QString &line, qint64 numLine)
 void GameWatcher::processZone(QString &line, qint64 numLine)
 {
     if(powerState == noGame)   return;
+    //Prefiltro literal: todos los patrones de zone son "zone from" o "pos from"
+    if(!line.contains(QLatin1String(" from ")))    return;
 
     //Carta desconocida
     //[entityName=UNKNOWN ENTITY [cardType=INVALID] id=69 zone=HAND zonePos=0 cardId= player=2] zone from OPPOSING DECK -> OPPOSING HAND
-    if(line.contains(QRegularExpression(
-        "\\[entityName=UNKNOWN ENTITY \\[cardType=INVALID\\] id=(\\d+) zone=\\w+ zonePos=\\d+ cardId= player=\\d+\\] zone from "
-        "(\\w+ \\w+(?: \\(Weapon\\))?)? -> (\\w+ \\w+(?: \\((?:Weapon|Hero|Hero Power)\\))?)?"
-        ), match))
+    if(line.contains(pattern(znUnknownCard), match))
     {
         QString id = match->captured(1);
         QString zoneFrom = match->captured(2);
@@ -1029,10 +1084,7 @@ void GameWatcher::processZone(QString &line, qint64 numLine)
     //Carta conocida
     //[entityName=Shellshifter id=32 zone=HAND zonePos=0 cardId=UNG_101 player=1] zone from FRIENDLY DECK -> FRIENDLY HAND
     //[entityName=Shellshifter id=32 zone=DECK zonePos=0 cardId= player=1] zone from FRIENDLY HAND -> FRIENDLY DECK
-    else if(line.contains(QRegularExpression(
-        "\\[entityName=(.*) id=(\\d+) zone=\\w+ zonePos=(\\d+) cardId=(\\w*) player=(\\d+)\\] zone from "
-        "(\\w+ \\w+(?: \\(Weapon\\))?)? -> (\\w+ \\w+(?: \\((?:Weapon|Hero|Hero Power)\\))?)?"
-        ), match))
+    else if(line.contains(pattern(znKnownCard), match))
     {
         QString name = match->captured(1);
         QString id = match->captured(2);
@@ -1432,9 +1484,7 @@ void GameWatcher::processZone(QString &line, qint64 numLine)
     //Ej: Si un esbirro con deathrattle produce otro esbirro. Primero se cambia la pos de los esbirros a la dcha
     //y despues se genran los esbirros de deathrattle causando una suma erronea.
     //id=7 local=True [entityName=Ingeniera novata id=25 zone=HAND zonePos=5 cardId=EX1_015 player=1] pos from 5 -> 3
-    else if(line.contains(QRegularExpression(
-        "\\[entityName=(.*) id=(\\d+) zone=(?:HAND|PLAY) zonePos=\\d+ cardId=\\w+ player=(\\d+)\\] pos from \\d+ -> (\\d+)"
-        ), match))
+    else if(line.contains(pattern(znPosChange), match))
     {
         QString name = match->captured(1);
         QString id = match->captured(2);
@@ -1609,9 +1659,11 @@ bool GameWatcher::advanceTurn(bool playerDraw)
 }
 
 
-LoadingScreenState GameWatcher::getLoadingScreen()
+//MainWindow guarda una copia en el hilo del GUI.
+void GameWatcher::setLoadingScreen(LoadingScreenState value)
 {
-    return this->loadingScreenState;
+    this->loadingScreenState = value;
+    emit loadingScreenChanged(value);
 }
 
 
@@ -3,6 +3,8 @@
 
 #include <QObject>
 #include <QString>
+#include <QVector>
+#include <QRegularExpression>
 #include "Cards/secretcard.h"
 #include "utility.h"
 
@@ -52,6 +54,18 @@ public:
 private:
     enum PowerState { noGame, heroType1State, heroType2State, mulliganState, inGameState };
     enum ArenaState { noDeckRead, deckRead, readingDeck };
+    //Patrones de log precompilados, agrupados por log/powerState (ver initPatterns())
+    enum LogPattern {
+        lsSceneLoaded,
+        arOnChosen, arClientChooses, arDeckHeroRead, arDeckCard, arNewDeck, arChoosingHero,
+        pwWon, pwTurn,
+        phCreatingHero, phPlayerId, phWhizbangDeck,
+        pmEntityChoices, pmMulliganDone, pmCoinEntity,
+        pgShowTag, pgTagChangePlayer, pgTagChangeUnknown, pgTagChangeKnown, pgBlockUnknown,
+        pgShowEntityKnown, pgShowEntityUnknown, pgFullEntity, pgChangeEntity, pgBlock,
+        znUnknownCard, znKnownCard, znPosChange,
+        numLogPatterns
+    };
 
 //Variables
 private:
@@ -99,13 +113,12 @@ private:
     bool isHeroPower(QString code);
     QString createGameLog();
     void checkWhizbangDeck(qint64 numLine);
-
-public:
-    void reset();
-    LoadingScreenState getLoadingScreen();
-    void setCopyGameLogs(bool value);
+    void setLoadingScreen(LoadingScreenState value);
+    static QVector<QRegularExpression> initPatterns();
+    static const QRegularExpression &pattern(LogPattern logPattern);
 
 signals:
+    void loadingScreenChanged(LoadingScreenState loadingScreen);
     void newGameResult(GameResult gameResult, LoadingScreenState loadingScreen, QString logFileName, qint64 startGameEpoch);
     void newArena(QString hero);
     void arenaChoosingHeroe();
@@ -194,6 +207,8 @@ private slots:
 public slots:
     void processLogLine(LogComponent logComponent, QString line, qint64 numLine, qint64 logSeek);
     void setDeckRead(bool value=true);
+    void reset();
+    void setCopyGameLogs(bool value);
 };
 
 #endif // GAMEWATCHER_H
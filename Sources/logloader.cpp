@@ -12,7 +12,8 @@ LogLoader::LogLoader(QObject *parent) : QObject(parent)
     logComponentList.append("Arena");
     logComponentList.append("Asset");
 
-    match = new QRegularExpressionMatch();
+    fileWatcher = nullptr;
+    updateTimer = nullptr;
 }
 
 
@@ -26,8 +27,7 @@ bool LogLoader::init()
     updateTime = 1000;
 
     createLogWorkers();
-
-    QTimer::singleShot(1, this, SLOT(sendLogWorkerFirstRun())); //Retraso para dejar que la aplicacion se pinte.
+    //La primera lectura (sendLogWorkerFirstRun) empieza al arrancar el hilo de logs (MainWindow::createLogThread)
     return true;
 }
 
@@ -275,12 +275,80 @@ LogLoader::~LogLoader()
 {
     foreach(LogWorker *worker, logWorkerMap.values())   delete worker;
     logWorkerMap.clear();
-    delete match;
+}
+
+
+//Se crean en sendLogWorkerFirstRun para que vivan en el hilo de logs.
+void LogLoader::createFileWatcher()
+{
+    updateTimer = new QTimer(this);
+    updateTimer->setSingleShot(true);
+    connect(updateTimer, SIGNAL(timeout()),
+            this, SLOT(sendLogWorker()));
+
+    fileWatcher = new QFileSystemWatcher(this);
+    if(!fileWatcher->addPath(logsDirPath))
+    {
+        emit pDebug("Cannot watch logs dir. Polling only.", DebugLevel::Warning);
+    }
+    watchLogFiles();
+
+    connect(fileWatcher, SIGNAL(fileChanged(QString)),
+            this, SLOT(logFileChanged()));
+    connect(fileWatcher, SIGNAL(directoryChanged(QString)),
+            this, SLOT(logDirChanged()));
+}
+
+
+//Los logs que no existian o que HS ha recreado desaparecen del watcher, hay que volver a vigilarlos.
+void LogLoader::watchLogFiles()
+{
+    QStringList watchedFiles = fileWatcher->files();
+
+    foreach(QString component, logComponentList)
+    {
+        QString logPath = logsDirPath + "/" + component + ".log";
+        if(!watchedFiles.contains(logPath) && QFileInfo(logPath).exists())
+        {
+            if(fileWatcher->addPath(logPath))   emit pDebug("Watching " + component + ".log");
+        }
+    }
+}
+
+
+//Adelanta la siguiente lectura, las rafagas de escrituras se agrupan en una sola lectura.
+void LogLoader::logFileChanged()
+{
+    updateTime = MIN_UPDATE_TIME;
+    if(updateTimer->isActive() && updateTimer->remainingTime() > WATCHER_DELAY_TIME)
+    {
+        updateTimer->start(WATCHER_DELAY_TIME);
+    }
+}
+
+
+void LogLoader::logDirChanged()
+{
+    watchLogFiles();
+    logFileChanged();
+}
+
+
+//Con el fileWatcher activo el polling solo es un respaldo.
+//En Windows los cambios en un fichero abierto por HS se notifican tarde, alli se mantiene el polling normal.
+int LogLoader::getMaxUpdateTime()
+{
+#ifndef Q_OS_WIN
+    if(fileWatcher != nullptr && !fileWatcher->files().isEmpty())   return FALLBACK_UPDATE_TIME;
+#endif
+    return maxUpdateTime;
 }
 
 
 void LogLoader::sendLogWorkerFirstRun()
 {
+    createFileWatcher();
+
     foreach(QString logComponent, logComponentList)
     {
         LogWorker *logWorker = logWorkerMap[logComponent];
@@ -293,7 +361,7 @@ void LogLoader::sendLogWorkerFirstRun()
         }
     }
 
-    QTimer::singleShot(updateTime, this, SLOT(sendLogWorker()));
+    updateTimer->start(updateTime);
     emit synchronized();
 }
 
@@ -303,24 +371,43 @@ void LogLoader::sendLogWorker()
     foreach(QString logComponent, logComponentList)     logWorkerMap[logComponent]->readLog();
     processDataLogs();
 
-    QTimer::singleShot(updateTime, this, SLOT(sendLogWorker()));
-    if(updateTime < maxUpdateTime)  updateTime += UPDATE_TIME_STEP;
+    updateTimer->start(updateTime);
+    if(updateTime < getMaxUpdateTime())  updateTime += UPDATE_TIME_STEP;
 }
 
 
+//Merge de las colas de cada log. Cada cola ya esta en orden, en cada paso se emite la linea
+//con menor timeStamp de entre las cabezas. En empate gana el LogComponent menor y dentro de un log se mantiene el orden de lectura.
+//Las lecturas con LOG_BATCH_LINES o mas lineas van entre logBatchStarted y logBatchFinished para que el GUI repinte una sola vez.
 void LogLoader::processDataLogs()
 {
-    if(dataLogs.isEmpty())  return;
-
-    QList<qint64> timeStamps = dataLogs.keys();
-    qSort(timeStamps);
+    int heads[logInvalid] = {};
+    int numLines = 0;
+    for(int i=0; i<logInvalid; i++)     numLines += dataLogs[i].size();
+    const bool batch = (numLines >= LOG_BATCH_LINES);
+    if(batch)   emit logBatchStarted();
 
-    foreach(qint64 timeStamp, timeStamps)
+    while(true)
     {
-        DataLog dataLog = dataLogs[timeStamp];
+        int next = -1;
+        for(int i=0; i<logInvalid; i++)
+        {
+            if(heads[i] < dataLogs[i].size() &&
+                (next == -1 || dataLogs[i].at(heads[i]).timeStamp < dataLogs[next].at(heads[next]).timeStamp))
+            {
+                next = i;
+            }
+        }
+        if(next == -1)  break;
+
+        const DataLog &dataLog = dataLogs[next].at(heads[next]++);
         emit newLogLineRead(dataLog.logComponent, dataLog.line, dataLog.numLine, dataLog.logSeek);
     }
-    dataLogs.clear();
+
+    if(batch)   emit logBatchFinished();
+
+    //clear() mantiene la capacidad de los QVector, no hay reservas nuevas en cada lectura
+    for(int i=0; i<logInvalid; i++)     dataLogs[i].clear();
 }
 
 
@@ -361,19 +448,68 @@ QString LogLoader::getLogsDirPath()
 }
 
 
+//Lee el primer "H:M:S.F " de la linea, equivale al antiguo regex (\d+):(\d+):(\d+).(\d+) (.*)
+//timeStamp en unidades de 100ns (7 decimales en los logs de HS), textStart es el inicio del texto tras el timeStamp.
+bool LogLoader::parseTimeStamp(const QString &line, qint64 &timeStamp, int &textStart)
+{
+    const QChar *data = line.constData();
+    const int length = line.length();
+
+    for(int start=0; start<length; start++)
+    {
+        if(!data[start].isDigit() || (start > 0 && data[start-1].isDigit()))   continue;
+
+        qint64 fields[4] = {0, 0, 0, 0};
+        int fracDigits = 0;
+        int pos = start;
+        bool valid = true;
+
+        for(int field=0; field<4 && valid; field++)
+        {
+            int digitsStart = pos;
+            while(pos < length && data[pos].isDigit())
+            {
+                if(field < 3 || fracDigits < 7)
+                {
+                    fields[field] = fields[field]*10 + data[pos].digitValue();
+                    if(field == 3)  fracDigits++;
+                }
+                pos++;
+            }
+
+            if(pos == digitsStart || pos >= length)                 valid = false;
+            else if(field < 2 && data[pos] != QLatin1Char(':'))    valid = false;
+            else if(field == 3 && data[pos] != QLatin1Char(' '))   valid = false;
+            else                                                    pos++;//':', '.' (cualquier caracter) o ' '
+        }
+        if(!valid)  continue;
+
+        for(; fracDigits<7; fracDigits++)   fields[3] *= 10;
+        timeStamp = ((fields[0]*60 + fields[1])*60 + fields[2])*10000000 + fields[3];
+        textStart = pos;
+        return true;
+    }
+    return false;
+}
+
+
 void LogLoader::addToDataLogs(LogComponent logComponent, QString line, qint64 numLine, qint64 logSeek)
 {
-    if(line.contains(QRegularExpression("(\\d+):(\\d+):(\\d+).(\\d+) (.*)"), match))
+    qint64 timeStamp;
+    int textStart;
+
+    if(logComponent != logInvalid && parseTimeStamp(line, timeStamp, textStart))
     {
+        int textEnd = line.length();
+        while(textEnd > textStart && (line.at(textEnd-1) == QLatin1Char('\n') || line.at(textEnd-1) == QLatin1Char('\r')))   textEnd--;
+
         DataLog dataLog;
         dataLog.logComponent = logComponent;
-        dataLog.line = match->captured(5);
+        dataLog.line = line.mid(textStart, textEnd - textStart);
         dataLog.numLine = numLine;
         dataLog.logSeek = logSeek;
-
-        qint64 timeStamp = QString(match->captured(1) + match->captured(2) + match->captured(3) + match->captured(4)).toLongLong();
-        while(dataLogs.contains(timeStamp))     timeStamp++;
-        dataLogs[timeStamp] = dataLog;
+        dataLog.timeStamp = timeStamp;
+        dataLogs[logComponent].append(dataLog);
     }
     else
     {
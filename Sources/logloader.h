@@ -5,10 +5,15 @@
 #include "logworker.h"
 #include <QObject>
 #include <QTextStream>
+#include <QTimer>
+#include <QFileSystemWatcher>
 
 #define MIN_UPDATE_TIME 500
 #define MAX_UPDATE_TIME 2000
 #define UPDATE_TIME_STEP 500
+#define FALLBACK_UPDATE_TIME 10000
+#define WATCHER_DELAY_TIME 50
+#define LOG_BATCH_LINES 50
 
 
 class DataLog
@@ -18,6 +23,7 @@ public:
     QString line;
     qint64 numLine;
     qint64 logSeek;
+    qint64 timeStamp;
 };
 
 
@@ -37,12 +43,15 @@ private:
     QList<QString> logComponentList;
     int updateTime, maxUpdateTime;
     bool sortLogs;
-    QMap<qint64,DataLog> dataLogs;
-    QRegularExpressionMatch *match;
+    QVector<DataLog> dataLogs[logInvalid];//Una cola por LogComponent, cada una ya ordenada
+    QFileSystemWatcher *fileWatcher;
+    QTimer *updateTimer;
 
 //Metodos
 private:
     void createFileWatcher();
+    void watchLogFiles();
+    int getMaxUpdateTime();
     bool readSettings();
     bool readLogsDirPath();
     bool readLogConfigPath();
@@ -54,6 +63,7 @@ private:
     void createLogWorker(QString logComponent);
     void addToDataLogs(LogComponent logComponent, QString line, qint64 numLine, qint64 logSeek);
     void processDataLogs();
+    bool parseTimeStamp(const QString &line, qint64 &timeStamp, int &textStart);
     QString findLinuxLogs(QString pattern);
 
 public:
@@ -66,6 +76,8 @@ signals:
     void synchronized();
     void logReset();
     void logConfigSet();
+    void logBatchStarted();
+    void logBatchFinished();
     void showMessageProgressBar(QString text);
     void pLog(QString line);
     void pDebug(QString line, DebugLevel debugLevel=Normal, QString file="LogLoader");
@@ -81,6 +93,8 @@ private slots:
 
     void sendLogWorker();
     void sendLogWorkerFirstRun();
+    void logFileChanged();
+    void logDirChanged();
 
 public slots:
     void setUpdateTimeMax();
@@ -1,20 +1,25 @@
 #include "logworker.h"
 #include <QtWidgets>
+#ifndef Q_OS_WIN
+#include <sys/stat.h>
+#endif
 
 
 LogWorker::LogWorker(QObject *parent, const QString &logsDirPath, const QString &logComponentString) : QObject(parent)
 {
     this->logSeek = 0;
     this->logNumLine = 0;
+    this->lastLineFiltered = false;
     this->logComponentString = logComponentString;
     this->logPath = logsDirPath + "/" + logComponentString + ".log";
     this->logSize = QFileInfo (logPath).size();
+    this->logFile.setFileName(logPath);
     initLogComponent(logComponentString);
 }
 
 LogWorker::~LogWorker()
 {
-
+    closeLog();
 }
 
 
@@ -52,6 +57,8 @@ void LogWorker::reset()
     logSeek = 0;
     logNumLine = 0;
     logSize = 0;
+    lastLineFiltered = false;
+    closeLog();
 }
 
 
@@ -59,10 +66,10 @@ bool LogWorker::isLogReset()
 {
     qint64 newSize = QFileInfo (logPath).size();
 
-    if(newSize < logSize)
+    if(newSize < logSize || isLogReplaced())
     {
         //Log se ha reiniciado
-        emit pDebug("Log " + logComponentString + " reset. FileSize: " + QString::number(newSize) + " < " + QString::number(logSize));
+        emit pDebug("Log " + logComponentString + " reset. FileSize: " + QString::number(newSize) + " - " + QString::number(logSize));
         emit logReset();
         reset();
         return true;
@@ -75,49 +82,118 @@ bool LogWorker::isLogReset()
 }
 
 
-int LogWorker::readLine(QFile &file, QString &utf8Line)
+//El fichero abierto ya no es el de logPath: HS lo ha borrado y creado de nuevo,
+//aunque el nuevo aun no sea mas pequeno que logSize.
+bool LogWorker::isLogReplaced()
 {
-    char c;
-    int lineLength = 0;
-    QByteArray line;
+#ifdef Q_OS_WIN
+    return false;//En Windows el log se cierra tras cada lectura
+#else
+    if(!logFile.isOpen())   return false;
+
+    struct stat pathStat, fileStat;
+    if(stat(QFile::encodeName(logPath).constData(), &pathStat) != 0)    return false;
+    if(fstat(logFile.handle(), &fileStat) != 0)                         return false;
+    return pathStat.st_ino != fileStat.st_ino || pathStat.st_dev != fileStat.st_dev;
+#endif
+}
 
-    while(true)
+
+//Fuera de Windows el log se mantiene abierto entre lecturas, solo se reabre tras un reset.
+bool LogWorker::openLog()
+{
+    if(logFile.isOpen())    return true;
+
+    if(!logFile.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
     {
-        if(!file.getChar(&c))    return -1;
-        line.append(c);
-        lineLength++;
-        if(c == '\n')
-        {
-            utf8Line = QString::fromUtf8(line);
-            return lineLength;
-        }
+        emit pDebug("Cannot open log " + this->logComponentString, DebugLevel::Error);
+        return false;
     }
+
+    logFile.seek(logSeek);
+    readBuffer.clear();
+    return true;
 }
 
 
-void LogWorker::readLog()
+void LogWorker::closeLog()
 {
-    isLogReset();
+    if(logFile.isOpen())    logFile.close();
+    readBuffer.clear();
+}
 
-    QFile logFile(logPath);
-    if(!logFile.open(QIODevice::ReadOnly))
+
+//Lineas de Power.log que GameWatcher nunca usa, se descartan antes de decodificar UTF-8.
+//Devuelve el inicio del texto filtrado (tras el timeStamp) o -1 si la linea no se filtra.
+int LogWorker::findFilteredText(const char *data, int length)
+{
+    if(logComponent != logPower)    return -1;
+
+    const QByteArray line = QByteArray::fromRawData(data, length);
+    int index = line.indexOf("GameState.DebugPrintOptions()");
+    if(index == -1) index = line.indexOf("GameState.SendOption()");
+    if(index == -1) index = line.indexOf("PowerProcessor.");
+    return index;
+}
+
+
+//Separa las lineas completas del buffer sin copiarlas, la linea incompleta del final
+//se queda en el buffer hasta la siguiente lectura.
+void LogWorker::processReadBuffer()
+{
+    const char *data = readBuffer.constData();
+    const int size = readBuffer.size();
+    int lineStart = 0;
+
+    while(lineStart < size)
     {
-        emit pDebug("Cannot open log " + this->logComponentString, DebugLevel::Error);
-        return;
+        const char *lineEnd = static_cast<const char *>(memchr(data + lineStart, '\n', static_cast<size_t>(size - lineStart)));
+        if(lineEnd == nullptr)  break;
+
+        int lineLength = static_cast<int>(lineEnd - data) + 1 - lineStart;
+        ++logNumLine;
+        int filteredText = findFilteredText(data + lineStart, lineLength);
+        if(filteredText == -1)
+        {
+            emit newLogLineRead(logComponent, QString::fromUtf8(data + lineStart, lineLength), logNumLine, logSeek);
+            lastLineFiltered = false;
+        }
+        //GameWatcher reinicia su estado (lastShowEntity) con cualquier linea que no sea de PowerTaskList,
+        //de cada racha de lineas filtradas se envia solo el timeStamp para mantener el orden del merge.
+        else if(!lastLineFiltered)
+        {
+            emit newLogLineRead(logComponent, QString::fromLatin1(data + lineStart, filteredText), logNumLine, logSeek);
+            lastLineFiltered = true;
+        }
+        logSeek += lineLength;
+        lineStart += lineLength;
     }
 
-    logFile.seek(logSeek);
+    readBuffer.remove(0, lineStart);
+}
 
-    QString line;
-    int lineLenght;
 
-    while((lineLenght = readLine(logFile, line)) > 0)
+void LogWorker::readLog()
+{
+    isLogReset();
+    if(!openLog())  return;
+
+    while(true)
     {
-        emit newLogLineRead(logComponent, line, ++logNumLine, logSeek);
-        logSeek += lineLenght;
+        int bufferSize = readBuffer.size();
+        readBuffer.resize(bufferSize + READ_BLOCK_SIZE);
+        qint64 bytesRead = logFile.read(readBuffer.data() + bufferSize, READ_BLOCK_SIZE);
+        readBuffer.resize(bufferSize + static_cast<int>(std::max(bytesRead, qint64(0))));
+
+        if(bytesRead <= 0)  break;
+        processReadBuffer();
     }
 
-    logFile.close();
+#ifdef Q_OS_WIN
+    //QFile abre sin FILE_SHARE_DELETE, mantenerlo abierto impediria a HS borrar/rotar el log.
+    //logSeek apunta al final de la ultima linea completa, la incompleta se vuelve a leer al reabrir.
+    closeLog();
+#endif
 }
 
 
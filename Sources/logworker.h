@@ -5,6 +5,8 @@
 #include <QObject>
 #include <QFile>
 
+#define READ_BLOCK_SIZE 65536
+
 class LogWorker : public QObject
 {
     Q_OBJECT
@@ -17,13 +19,20 @@ private:
     qint64 logSeek, logNumLine, logSize;
     QString logPath, logComponentString;
     LogComponent logComponent;
+    QFile logFile;
+    QByteArray readBuffer;
+    bool lastLineFiltered;
 
 
 //Metodos
 private:
     void doCopyGameLog(qint64 logSeekCreate, qint64 logSeekWon, QString fileName);
-    int readLine(QFile &file, QString &utf8Line);
+    bool openLog();
+    void closeLog();
+    void processReadBuffer();
+    int findFilteredText(const char *data, int length);
     bool isLogReset();
+    bool isLogReplaced();
     void reset();
     void initLogComponent(QString logComponentString);
 
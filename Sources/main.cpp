@@ -1,12 +1,24 @@
 #include "mainwindow.h"
+#include "capturebenchmark.h"
 #include <QApplication>
 #include <QSplashScreen>
 #include <QStyleFactory>
+#include <QPixmapCache>
 
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
     app.setStyle(QStyleFactory::create("Fusion"));
+    QPixmapCache::setCacheLimit(CARD_PIXMAP_CACHE_KB);
+
+    //Benchmark offline del reconocimiento de cartas: ArenaTracker --benchmark <dir>
+    const QStringList arguments = app.arguments();
+    const int benchmarkIndex = arguments.indexOf("--benchmark");
+    if(benchmarkIndex != -1 && benchmarkIndex + 1 < arguments.count())
+    {
+        CaptureBenchmark captureBenchmark;
+        return captureBenchmark.run(arguments[benchmarkIndex + 1])?0:1;
+    }
 
     QPixmap pixmap(":/Images/splash.png");
     QSplashScreen splash(pixmap, Qt::WindowStaysOnTopHint);
@@ -29,11 +29,13 @@ MainWindow::MainWindow(QWidget *parent) :
     graveyardWindow = nullptr;
     planWindow = nullptr;
     copyGameLogs = false;
+    loadingScreen = menu;
     draftLogFile = "";
     cardHeight = -1;
 
     logLoader = nullptr;
     gameWatcher = nullptr;
+    logThread = nullptr;
     arenaHandler = nullptr;
     cardDownloader = nullptr;
     enemyHandHandler = nullptr;
@@ -88,6 +90,11 @@ MainWindow::~MainWindow()
 {
     if(networkManager != nullptr)      delete networkManager;
     if(premiumHandler != nullptr)      delete premiumHandler;
+    if(logThread != nullptr)
+    {
+        logThread->quit();
+        logThread->wait();
+    }
     if(logLoader != nullptr)           delete logLoader;
     if(gameWatcher != nullptr)         delete gameWatcher;
     if(arenaHandler != nullptr)        delete arenaHandler;
@@ -209,15 +216,9 @@ void MainWindow::closedDetachWindow(DetachWindow *detachWindow, QWidget *paneWid
 }
 
 
-void MainWindow::resetDeckDontRead()
-{
-    resetDeck(true);
-}
-
-
-void MainWindow::resetDeck(bool deckRead)
+//GameWatcher actualiza su arenaState antes de emitir newArena/needResetDeck
+void MainWindow::resetDeck()
 {
-    gameWatcher->setDeckRead(deckRead);
     deckHandler->reset();
 }
 
@@ -299,22 +300,62 @@ QString MainWindow::getHSLanguage()
 }
 
 
-void MainWindow::createCardsJsonMap(QByteArray &jsonData)
+void MainWindow::createCardTable(QByteArray &jsonData)
 {
-    emit pDebug("Create Json Map.");
+    emit pDebug("Create Card Table.");
 
     QJsonDocument jsonDoc = QJsonDocument::fromJson(jsonData);
     QJsonArray jsonArray = jsonDoc.array();
+    QJsonObject cardsObject;
     foreach(QJsonValue jsonCard, jsonArray)
     {
         QJsonObject jsonCardObject = jsonCard.toObject();
-        cardsJson[jsonCardObject.value("id").toString()] = jsonCardObject;
+        cardsObject[jsonCardObject.value("id").toString()] = jsonCardObject;
     }
 
+    Utility::setCardsJson(cardsObject);
+    saveCardsBin(cardsObject);
+
     emit cardsJsonReady();
 }
 
 
+//cards.bin es el cardTable compilado a partir de cards.json (ver CardTable::save).
+//Se usa mientras cardsBinVersion coincida con cardsJsonVersion, sin volver a parsear cards.json.
+bool MainWindow::loadCardsBin()
+{
+    QSettings settings("Arena Tracker", "Arena Tracker");
+    QString cardsJsonVersion = settings.value("cardsJsonVersion", "").toString();
+    QString cardsBinVersion = settings.value("cardsBinVersion", "").toString();
+    if(cardsJsonVersion.isEmpty() || cardsBinVersion != cardsJsonVersion)   return false;
+
+    if(!Utility::loadCardsBin())
+    {
+        emit pDebug("Extra: Json Cards --> cards.bin invalid.");
+        return false;
+    }
+
+    emit pDebug("Create Card Table from cards.bin.");
+    return true;
+}
+
+
+void MainWindow::saveCardsBin(const QJsonObject &cardsObject)
+{
+    QSettings settings("Arena Tracker", "Arena Tracker");
+    settings.remove("cardsBinVersion");
+
+    if(Utility::saveCardsBin(cardsObject))
+    {
+        settings.setValue("cardsBinVersion", settings.value("cardsJsonVersion", "").toString());
+    }
+    else
+    {
+        emit pDebug("ERROR: Failed to write cards.bin");
+    }
+}
+
+
 void MainWindow::replyFinished(QNetworkReply *reply)
 {
     reply->deleteLater();
@@ -343,7 +384,7 @@ void MainWindow::replyFinished(QNetworkReply *reply)
                 settings.setValue("cardsJsonVersion", fullUrl);
                 QByteArray jsonData = reply->readAll();
                 Utility::dumpOnFile(jsonData, Utility::extraPath() + "/cards.json");
-                createCardsJsonMap(jsonData);
+                createCardTable(jsonData);
             }
         }
         //HSR Heroes Winrate
@@ -469,17 +510,32 @@ void MainWindow::checkCardsJsonVersion(QString cardsJsonVersion)
 void MainWindow::setLocalLang()
 {
     QString lang = getHSLanguage();
-    Utility::setLocalLang(lang);
+    if(!Utility::setLocalLang(lang))
+    {
+        emit pDebug("Extra: Json Cards --> " + lang + " not in cards.bin.");
+        loadCardsJson();
+    }
 }
 
 
 void MainWindow::initCardsJson()
 {
-    Utility::setCardsJson(&cardsJson);
     networkManager->get(QNetworkRequest(QUrl(JSON_CARDS_URL)));
     emit pDebug("Extra: Json Cards --> Trying: " + QString(JSON_CARDS_URL));
 
-    //Load local cards.json (Incluso aunque haya una version nueva para bajar)
+    //Load local cards.bin/cards.json (Incluso aunque haya una version nueva para bajar)
+    if(loadCardsBin())
+    {
+        emit cardsJsonReady();
+        return;
+    }
+
+    loadCardsJson();
+}
+
+
+void MainWindow::loadCardsJson()
+{
     QFile cardsJsonFile(Utility::extraPath() + "/cards.json");
     if(cardsJsonFile.exists())
     {
@@ -490,7 +546,7 @@ void MainWindow::initCardsJson()
         }
         QByteArray jsonData = cardsJsonFile.readAll();
         cardsJsonFile.close();
-        createCardsJsonMap(jsonData);
+        createCardTable(jsonData);
     }
 }
 
@@ -682,6 +738,8 @@ void MainWindow::createDraftHandler()
 
     connect(ui->minimizeButton, SIGNAL(clicked()),
             draftHandler, SLOT(minimizeScoreWindow()));
+    connect(this, SIGNAL(cardsJsonReady()),
+            draftHandler, SLOT(clearSynergyFlags()));
 
     downloadHSRHeroesWinrate();
 }
@@ -927,14 +985,16 @@ void MainWindow::createCardDownloader()
 
 void MainWindow::createGameWatcher()
 {
-    gameWatcher = new GameWatcher(this);
+    gameWatcher = new GameWatcher();
 
     connect(gameWatcher, SIGNAL(newArena(QString)),
-            this, SLOT(resetDeckDontRead()));
+            this, SLOT(resetDeck()));
     connect(gameWatcher, SIGNAL(needResetDeck()),
             this, SLOT(resetDeck()));
     connect(gameWatcher, SIGNAL(arenaDeckRead()),
             this, SLOT(completeArenaDeck()));
+    connect(gameWatcher, SIGNAL(loadingScreenChanged(LoadingScreenState)),
+            this, SLOT(setLoadingScreen(LoadingScreenState)));
     connect(gameWatcher, SIGNAL(pLog(QString)),
             this, SLOT(pLog(QString)));
     connect(gameWatcher, SIGNAL(pDebug(QString,qint64,DebugLevel,QString)),
@@ -1163,13 +1223,19 @@ void MainWindow::createGameWatcher()
 
 void MainWindow::createLogLoader()
 {
-    logLoader = new LogLoader(this);
+    logLoader = new LogLoader(nullptr);
+    connect(logLoader, SIGNAL(logReset()),
+            gameWatcher, SLOT(reset()));
     connect(logLoader, SIGNAL(logReset()),
             this, SLOT(logReset()));
     connect(logLoader, SIGNAL(newLogLineRead(LogComponent, QString,qint64,qint64)),
             gameWatcher, SLOT(processLogLine(LogComponent, QString,qint64,qint64)));
     connect(logLoader, SIGNAL(logConfigSet()),
             this, SLOT(setLocalLang()));
+    connect(logLoader, SIGNAL(logBatchStarted()),
+            this, SLOT(startLogBatch()));
+    connect(logLoader, SIGNAL(logBatchFinished()),
+            this, SLOT(finishLogBatch()));
     connect(logLoader, SIGNAL(showMessageProgressBar(QString)),
             this, SLOT(showMessageProgressBar(QString)));
     connect(logLoader, SIGNAL(pLog(QString)),
@@ -1186,6 +1252,27 @@ void MainWindow::createLogLoader()
             logLoader, SLOT(setUpdateTimeMin()));
 
     if(!logLoader->init())  QTimer::singleShot(1, this, SLOT(closeApp()));
+    else                    createLogThread();
+}
+
+
+//LogLoader (con sus LogWorkers) y GameWatcher leen y parsean los logs en su propio hilo.
+//Sus signals llegan a los handlers como QueuedConnection, en el mismo orden en que se emitieron.
+//Las rafagas grandes llegan entre logBatchStarted y logBatchFinished y se repintan una sola vez.
+//GameWatcher solo consulta las cartas a traves del snapshot de Utility::cardTable.
+void MainWindow::createLogThread()
+{
+    qRegisterMetaType<DebugLevel>("DebugLevel");
+    qRegisterMetaType<LoadingScreenState>("LoadingScreenState");
+    qRegisterMetaType<CardClass>("CardClass");
+    qRegisterMetaType<GameResult>("GameResult");
+
+    logThread = new QThread(this);
+    logLoader->moveToThread(logThread);
+    gameWatcher->moveToThread(logThread);
+    connect(logThread, SIGNAL(started()),
+            logLoader, SLOT(sendLogWorkerFirstRun()));
+    logThread->start();
 }
 
 
@@ -2245,7 +2332,6 @@ void MainWindow::logReset()
     deckHandler->unlockDeckInterface();
     deckHandler->leaveArena();
     enemyHandHandler->unlockEnemyInterface();
-    gameWatcher->reset();
 }
 
 
@@ -2267,6 +2353,8 @@ bool MainWindow::checkCardImage(QString code, bool isHero)
 
 void MainWindow::redrawDownloadedCardImage(QString code)
 {
+    Utility::removeCardPixmap(code);
+    DeckCard::clearDrawCache();
     deckHandler->redrawDownloadedCardImage(code);
     enemyDeckHandler->redrawDownloadedCardImage(code);
     graveyardHandler->redrawDownloadedCardImage(code);
@@ -2987,6 +3075,9 @@ void MainWindow::redrawAllGames()
 
 void MainWindow::spreadTheme(bool redrawAllGames)
 {
+    //Repintamos una sola vez al final
+    setUpdatesEnabled(false);
+    DeckCard::clearDrawCache();
     updateMainUITheme();
     updateTabIcons();
     arenaHandler->setTheme();
@@ -3004,6 +3095,7 @@ void MainWindow::spreadTheme(bool redrawAllGames)
     if(redrawAllGames) this->redrawAllGames();
     resizeChecks();//Recoloca botones -X
     calculateMinimumWidth();//Si hay borde cambia el minimumWidth
+    setUpdatesEnabled(true);
 }
 
 
@@ -3284,6 +3376,7 @@ void MainWindow::spreadTamCard(int value)
 
     this->cardHeight = value;
     DeckCard::setCardHeight(value);
+    setUpdatesEnabled(false);//Repintamos una sola vez al final
 
     if(deckHandler != nullptr)
     {
@@ -3311,6 +3404,7 @@ void MainWindow::spreadTamCard(int value)
     if(enemyWindow != nullptr)     calculateCardWindowMinimumWidth(enemyWindow, windowsWithBorders);
     if(enemyDeckWindow != nullptr) calculateCardWindowMinimumWidth(enemyDeckWindow, windowsWithBorders);
     if(graveyardWindow != nullptr) calculateCardWindowMinimumWidth(graveyardWindow, windowsWithBorders);
+    setUpdatesEnabled(true);
 }
 
 
@@ -3484,7 +3578,7 @@ void MainWindow::updateMaxGamesLog(int value)
     {
         copyGameLogs = true;
     }
-    gameWatcher->setCopyGameLogs(copyGameLogs);
+    QMetaObject::invokeMethod(gameWatcher, "setCopyGameLogs", Qt::QueuedConnection, Q_ARG(bool, copyGameLogs));
 
     QString labelText;
     if(value == 100)
@@ -3602,8 +3696,40 @@ int MainWindow::getScreenHighest()
 
 LoadingScreenState MainWindow::getLoadingScreen()
 {
-    if(gameWatcher != nullptr) return gameWatcher->getLoadingScreen();
-    else                    return menu;
+    return this->loadingScreen;
+}
+
+
+void MainWindow::setLoadingScreen(LoadingScreenState loadingScreen)
+{
+    this->loadingScreen = loadingScreen;
+}
+
+
+//Las signals de una rafaga grande del log llegan todas entre logBatchStarted y logBatchFinished,
+//las ventanas se repintan una sola vez al final en vez de con cada tag change.
+void MainWindow::startLogBatch()
+{
+    setLogBatchUpdatesEnabled(false);
+}
+
+
+void MainWindow::finishLogBatch()
+{
+    setLogBatchUpdatesEnabled(true);
+}
+
+
+//setUpdatesEnabled no se propaga a las DetachWindow, son ventanas independientes.
+void MainWindow::setLogBatchUpdatesEnabled(bool value)
+{
+    setUpdatesEnabled(value);
+    if(deckWindow != nullptr)       deckWindow->setUpdatesEnabled(value);
+    if(arenaWindow != nullptr)      arenaWindow->setUpdatesEnabled(value);
+    if(enemyWindow != nullptr)      enemyWindow->setUpdatesEnabled(value);
+    if(enemyDeckWindow != nullptr)  enemyDeckWindow->setUpdatesEnabled(value);
+    if(graveyardWindow != nullptr)  graveyardWindow->setUpdatesEnabled(value);
+    if(planWindow != nullptr)       planWindow->setUpdatesEnabled(value);
 }
 
 
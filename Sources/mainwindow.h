@@ -20,6 +20,7 @@
 #include "Widgets/cardlistwindow.h"
 #include <QMainWindow>
 #include <QJsonObject>
+#include <QThread>
 
 #define DIVIDE_TABS_H 444
 #define DIVIDE_TABS_H2 666
@@ -62,6 +63,7 @@ private:
     bool patreonVersion;
     LogLoader *logLoader;
     GameWatcher *gameWatcher;
+    QThread *logThread;
     HSCardDownloader *cardDownloader;
     EnemyDeckHandler *enemyDeckHandler;
     GraveyardHandler *graveyardHandler;
@@ -75,7 +77,6 @@ private:
     CardListWindow *cardListWindow;
     TrackobotUploader *trackobotUploader;
     PremiumHandler *premiumHandler;
-    QMap<QString, QJsonObject> cardsJson;
     QPoint dragPosition;
     QFile* atLogFile;
     bool mouseInApp;
@@ -89,6 +90,7 @@ private:
     bool draftLearningMode;
     QString draftLogFile;
     bool copyGameLogs;
+    LoadingScreenState loadingScreen;//Copia de GameWatcher::loadingScreenState, que vive en el hilo de logs
     QNetworkAccessManager *networkManager;
     QStringList allCardsDownloadList;
     TwitchHandler *twitchTester;
@@ -101,6 +103,7 @@ public:
 
 private:
     void createLogLoader();
+    void createLogThread();
     void createArenaHandler();
     void createGameWatcher();
     void createCardWindow();
@@ -132,7 +135,9 @@ private:
     void updateButtonsTheme();
     void updateTabWidgetsTheme(bool transparent, bool resizing);
     QString getHSLanguage();
-    void createCardsJsonMap(QByteArray &jsonData);
+    void createCardTable(QByteArray &jsonData);
+    bool loadCardsBin();
+    void saveCardsBin(const QJsonObject &cardsObject);
     void resizeTopButtons(int right, int top);
     void resizeChecks();
     void moveTabTo(QWidget *widget, QTabWidget *tabWidget);
@@ -141,6 +146,7 @@ private:
     void closeLogFile();
     void createDataDir();
     void calculateCardWindowMinimumWidth(DetachWindow *detachWindow, bool hasBorders);
+    void setLogBatchUpdatesEnabled(bool value);
     void initConfigTab(int tooltipScale, int cardHeight, bool autoSize, bool showClassColor, bool showSpellColor, bool showManaLimits, bool showTotalAttack, bool showRngList, int maxGamesLog, bool normalizedLF, bool twitchChatVotes, QString theme);
     void moveInScreen(QPoint pos, QSize size);
     int getScreenHighest();
@@ -153,6 +159,7 @@ private:
     int getAutoTamCard();
     void createNetworkManager();
     void initCardsJson();
+    void loadCardsJson();
     void removeHSCards();   //Desactivado: Remove HSCards when upgrading version
     void removeExtra();
     void checkCardsJsonVersion(QString cardsJsonVersion);
@@ -208,8 +215,7 @@ signals:
 //Slots
 public slots:
     //GameWatcher
-    void resetDeck(bool deckRead=false);
-    void resetDeckDontRead();
+    void resetDeck();
 
     //Multi Handlers
     bool checkCardImage(QString code, bool isHero=false);
@@ -252,6 +258,9 @@ private slots:
     void spreadMouseInApp();
     void updateMaxGamesLog(int value);
     void logReset();
+    void setLoadingScreen(LoadingScreenState loadingScreen);
+    void startLogBatch();
+    void finishLogBatch();
     void spreadCorrectTamCard();
     void completeArenaDeck();
     void changingTabResetSizePlan();
@@ -255,7 +255,7 @@ void PlanHandler::copyMinionToLastTurn(bool friendly, MinionGraphicsItem *minion
     if(idCreator == -1)     idCreator = this->lastTriggerId;
     emit pDebug("Triggered minion. Ids: " + QString::number(idCreator) + " --> " + QString::number(minion->getId()));
 
-    Board *board = turnBoards.last();
+    Board *board = getLastTurnBoard();
     QList<MinionGraphicsItem *> *minionsList = getMinionList(friendly, board);
     int pos = findMinionPos(minionsList, idCreator);
 
@@ -371,7 +371,7 @@ MinionGraphicsItem * PlanHandler::takeMinion(bool friendly, int id, bool stolen)
     //Marcar como dead minion en ultimo turno
     if(!turnBoards.empty())
     {
-        Board *board = turnBoards.last();
+        Board *board = getLastTurnBoard();
         minionsList = getMinionList(friendly, board);
         pos = findMinionPos(minionsList, id);
         if(pos != -1)
@@ -613,7 +613,7 @@ void PlanHandler::cardTagChangePrevTurn(int id, bool friendly, QString tag, QStr
 {
     if(turnBoards.empty())  return;
 
-    Board *board = turnBoards.last();
+    Board *board = getLastTurnBoard();
     if(board->playerTurn != friendly)   return;
 
     CardGraphicsItem *card = findCard(friendly, id, board);
@@ -717,8 +717,8 @@ void PlanHandler::addHeroPowerTagChange(const TagChange &tagChange)
 
     if(tagChange.tag == "EXHAUSTED" && tagChange.value == "1" && !turnBoards.empty())
     {
-        if(tagChange.friendly)  turnBoards.last()->playerHeroPower->processTagChange(tagChange.tag, tagChange.value);
-        else                    turnBoards.last()->enemyHeroPower->processTagChange(tagChange.tag, tagChange.value);
+        if(tagChange.friendly)  getLastTurnBoard()->playerHeroPower->processTagChange(tagChange.tag, tagChange.value);
+        else                    getLastTurnBoard()->enemyHeroPower->processTagChange(tagChange.tag, tagChange.value);
     }
 }
 
@@ -923,7 +923,7 @@ void PlanHandler::checkAtkHealthChange(MinionGraphicsItem * minion, bool friendl
     {
         if(turnBoards.empty())  return;
 
-        MinionGraphicsItem * minionLastTurn = findMinion(friendly, minion->getId(), turnBoards.last());
+        MinionGraphicsItem * minionLastTurn = findMinion(friendly, minion->getId(), getLastTurnBoard());
         if(minionLastTurn == nullptr)  return;
 
         int attack = minion->getAttack();
@@ -939,7 +939,7 @@ void PlanHandler::checkAtkHealthChange(MinionGraphicsItem * minion, bool friendl
     {
         if(turnBoards.empty())  return;
 
-        MinionGraphicsItem * minionLastTurn = findMinion(friendly, minion->getId(), turnBoards.last());
+        MinionGraphicsItem * minionLastTurn = findMinion(friendly, minion->getId(), getLastTurnBoard());
         if(minionLastTurn == nullptr)  return;
 
         int health = minion->getHealth();
@@ -1060,7 +1060,7 @@ void PlanHandler::zonePlayAttack(QString code, int id1, int id2)
     if(turnBoards.empty())  return;
 
     ArrowGraphicsItem *attack = new ArrowGraphicsItem();
-    Board *board = turnBoards.last();
+    Board *board = getLastTurnBoard();
 
     //To
     if(findAttackPoint(attack, false, id2, board))
@@ -1186,7 +1186,7 @@ void PlanHandler::killWeaponLastTurn(bool friendly, int id)
 {
     if(turnBoards.empty())  return;
 
-    Board *board = turnBoards.last();
+    Board *board = getLastTurnBoard();
     WeaponGraphicsItem* weapon = friendly?board->playerWeapon:board->enemyWeapon;
     if(weapon == nullptr)
     {
@@ -1285,7 +1285,7 @@ void PlanHandler::addAddonToLastTurn(QString code, int id1, int id2, Addon::Addo
 {
     if(turnBoards.empty())  return;
 
-    Board *board = turnBoards.last();
+    Board *board = getLastTurnBoard();
 
     if(board->playerHero != nullptr && board->playerHero->getId() == id2)
     {
@@ -1333,7 +1333,7 @@ bool PlanHandler::areThereAuras(bool friendly)
 
     //Check last turn board
     if(turnBoards.empty())  return false;
-    Board *board = turnBoards.last();
+    Board *board = getLastTurnBoard();
     minionsList = getMinionList(friendly, board);
     foreach(MinionGraphicsItem *minion, *minionsList)
     {
@@ -1376,7 +1376,7 @@ void PlanHandler::playerSecretRevealed(int id, QString code)
     nowBoard->playerHero->removeSecret(id);
 
     if(turnBoards.empty())  return;
-    Board *board = turnBoards.last();
+    Board *board = getLastTurnBoard();
     board->playerHero->showSecret(id, code);
 }
 
@@ -1387,7 +1387,7 @@ void PlanHandler::enemySecretRevealed(int id, QString code)
     nowBoard->enemyHero->removeSecret(id);
 
     if(turnBoards.empty())  return;
-    Board *board = turnBoards.last();
+    Board *board = getLastTurnBoard();
     board->enemyHero->showSecret(id, code);
 
     revealEnemyCardPrevTurns(id, code);
@@ -1520,7 +1520,7 @@ CardGraphicsItem * PlanHandler::cardDraw(bool friendly, int id, QString code, QS
     //Show card draw last turn
     if(!turnBoards.empty())
     {
-        Board *board = turnBoards.last();
+        Board *board = getLastTurnBoard();
         if(board->numTurn == turn)
         {
             CardGraphicsItem *drawCard = findCard(friendly, id, board);
@@ -1593,7 +1593,7 @@ void PlanHandler::cardPlayed(bool friendly, int id, QString code, bool discard)
     //Set played/discard last board
     if(!turnBoards.empty())
     {
-        Board *board = turnBoards.last();
+        Board *board = getLastTurnBoard();
         CardGraphicsItem *card = findCard(friendly, id, board);
 
         if(card == nullptr)
@@ -1617,8 +1617,17 @@ void PlanHandler::cardPlayed(bool friendly, int id, QString code, bool discard)
 
 void PlanHandler::revealEnemyCardPrevTurns(int id, QString code)
 {
+    bool compactBoards = false;
     foreach(Board *board, turnBoards)
     {
+        //Se aplica al materializar el board
+        if(!board->state.isEmpty())
+        {
+            board->revealedEnemyCards[id] = code;
+            compactBoards = true;
+            continue;
+        }
+
         CardGraphicsItem *card = findCard(false, id, board);
         if(card != nullptr)
         {
@@ -1626,13 +1635,14 @@ void PlanHandler::revealEnemyCardPrevTurns(int id, QString code)
             emit checkCardImage(code, false);
         }
     }
+    if(compactBoards)   emit checkCardImage(code, false);
 }
 
 
 void PlanHandler::fixTurn1Card()
 {
     if(turnBoards.empty())  return;
-    Board *board = turnBoards.last();
+    Board *board = getLastTurnBoard();
     QList<CardGraphicsItem *> *cardList = getHandList(board->playerTurn, board);
     if(!cardList->isEmpty())     cardList->last()->setDraw(false);
 }
@@ -1641,7 +1651,7 @@ void PlanHandler::fixTurn1Card()
 void PlanHandler::fixLastEchoCard()
 {
     if(turnBoards.empty())  return;
-    Board *board = turnBoards.last();
+    Board *board = getLastTurnBoard();
     QList<CardGraphicsItem *> *cardList = getHandList(board->playerTurn, board);
 
     if(cardList->isEmpty()) return;
@@ -1736,7 +1746,8 @@ void PlanHandler::newTurn(bool playerTurn, int numTurn)
     pendingTagChanges.clear();
 
     //Store nowBoard
-    turnBoards.append(copyBoard(nowBoard, numTurn));
+    turnBoards.append(compactBoardCopy(nowBoard, numTurn));
+    trimExpandedBoards();
     showManaPlayableCardsAuto();
     updateTurnSliderRange();
 
@@ -1802,6 +1813,171 @@ Board * PlanHandler::copyBoard(Board *origBoard, int numTurn, bool copySecretCod
 }
 
 
+//Los turnos pasados se guardan compactos (sin QGraphicsItems) y solo se materializan al verlos
+//o al corregir el ultimo turno. Equivale a copyBoard(origBoard, numTurn) seguido de compactBoard:
+//sin codes de secretos y con los minions normalizados como en su constructor de copia (asCopy).
+Board * PlanHandler::compactBoardCopy(Board *origBoard, int numTurn)
+{
+    Board *board = new Board();
+    board->playerTurn = origBoard->playerTurn;
+    board->numTurn = numTurn;
+
+    QDataStream stream(&board->state, QIODevice::WriteOnly);
+    saveBoardState(origBoard, stream, false, true);
+    return board;
+}
+
+
+void PlanHandler::saveBoardState(Board *board, QDataStream &stream, bool saveSecretCodes, bool asCopy)
+{
+    stream << (board->playerHero != nullptr) << (board->enemyHero != nullptr)
+           << (board->playerHeroPower != nullptr) << (board->enemyHeroPower != nullptr)
+           << (board->playerWeapon != nullptr) << (board->enemyWeapon != nullptr);
+    if(board->playerHero != nullptr)        board->playerHero->saveState(stream, saveSecretCodes, asCopy);
+    if(board->enemyHero != nullptr)         board->enemyHero->saveState(stream, saveSecretCodes, asCopy);
+    if(board->playerHeroPower != nullptr)   board->playerHeroPower->saveState(stream);
+    if(board->enemyHeroPower != nullptr)    board->enemyHeroPower->saveState(stream);
+    if(board->playerWeapon != nullptr)      board->playerWeapon->saveState(stream, asCopy);
+    if(board->enemyWeapon != nullptr)       board->enemyWeapon->saveState(stream, asCopy);
+
+    stream << static_cast<qint32>(board->playerMinions.count());
+    foreach(MinionGraphicsItem * minion, board->playerMinions)  minion->saveState(stream, asCopy);
+    stream << static_cast<qint32>(board->enemyMinions.count());
+    foreach(MinionGraphicsItem * minion, board->enemyMinions)   minion->saveState(stream, asCopy);
+    stream << static_cast<qint32>(board->playerHandList.count());
+    foreach(CardGraphicsItem * card, board->playerHandList)     card->saveState(stream);
+    stream << static_cast<qint32>(board->enemyHandList.count());
+    foreach(CardGraphicsItem * card, board->enemyHandList)      card->saveState(stream);
+
+    //Los extremos de las flechas se guardan como referencias a heroes/minions del board
+    stream << static_cast<qint32>(board->arrows.count());
+    foreach(ArrowGraphicsItem *arrow, board->arrows)
+    {
+        stream << static_cast<qint32>(arrow->getArrowType()) << static_cast<qint32>(arrow->getNumAttacks())
+               << getArrowEndRef(board, arrow->getEnd(true)) << getArrowEndRef(board, arrow->getEnd(false));
+    }
+}
+
+
+//Referencia de un extremo de flecha: -1 heroe amigo, -2 heroe enemigo, 2*pos minion amigo, 2*pos+1 minion enemigo.
+int PlanHandler::getArrowEndRef(Board *board, MinionGraphicsItem *item)
+{
+    if(item == board->playerHero)   return -1;
+    if(item == board->enemyHero)    return -2;
+    int pos = board->playerMinions.indexOf(item);
+    if(pos != -1)   return 2*pos;
+    pos = board->enemyMinions.indexOf(item);
+    if(pos != -1)   return 2*pos+1;
+    return -3;
+}
+
+
+MinionGraphicsItem * PlanHandler::getArrowEnd(Board *board, int ref)
+{
+    if(ref == -1)   return board->playerHero;
+    if(ref == -2)   return board->enemyHero;
+    if(ref < 0)     return nullptr;
+    QList<MinionGraphicsItem *> * minionsList = getMinionList(ref%2 == 0, board);
+    return minionsList->value(ref/2, nullptr);
+}
+
+
+void PlanHandler::compactBoard(Board *board)
+{
+    if(!board->state.isEmpty())     return;
+
+    QDataStream stream(&board->state, QIODevice::WriteOnly);
+    saveBoardState(board, stream, true, false);
+    resetBoard(board);
+    expandedTurnBoards.removeOne(board);
+}
+
+
+void PlanHandler::expandBoard(Board *board)
+{
+    expandedTurnBoards.removeOne(board);
+    expandedTurnBoards.prepend(board);
+    if(board->state.isEmpty())      return;
+
+    QDataStream stream(&board->state, QIODevice::ReadOnly);
+    bool playerHero, enemyHero, playerHeroPower, enemyHeroPower, playerWeapon, enemyWeapon;
+    stream >> playerHero >> enemyHero >> playerHeroPower >> enemyHeroPower >> playerWeapon >> enemyWeapon;
+    if(playerHero)      board->playerHero = new HeroGraphicsItem(stream, graphicsItemSender);
+    if(enemyHero)       board->enemyHero = new HeroGraphicsItem(stream, graphicsItemSender);
+    if(playerHeroPower) board->playerHeroPower = new HeroPowerGraphicsItem(stream, graphicsItemSender);
+    if(enemyHeroPower)  board->enemyHeroPower = new HeroPowerGraphicsItem(stream, graphicsItemSender);
+    if(playerWeapon)
+    {
+        board->playerWeapon = new WeaponGraphicsItem(stream, graphicsItemSender);
+        if(board->playerHero != nullptr)       board->playerHero->setHeroWeapon(board->playerWeapon, false);
+    }
+    if(enemyWeapon)
+    {
+        board->enemyWeapon = new WeaponGraphicsItem(stream, graphicsItemSender);
+        if(board->enemyHero != nullptr)        board->enemyHero->setHeroWeapon(board->enemyWeapon, false);
+    }
+
+    qint32 num;
+    stream >> num;
+    for(int i=0; i<num; i++)    board->playerMinions.append(new MinionGraphicsItem(stream, graphicsItemSender));
+    stream >> num;
+    for(int i=0; i<num; i++)    board->enemyMinions.append(new MinionGraphicsItem(stream, graphicsItemSender));
+    stream >> num;
+    for(int i=0; i<num; i++)    board->playerHandList.append(new CardGraphicsItem(stream, graphicsItemSender));
+    stream >> num;
+    for(int i=0; i<num; i++)    board->enemyHandList.append(new CardGraphicsItem(stream, graphicsItemSender));
+
+    stream >> num;
+    for(int i=0; i<num; i++)
+    {
+        qint32 arrowType, numAttacks, fromRef, toRef;
+        stream >> arrowType >> numAttacks >> fromRef >> toRef;
+        MinionGraphicsItem *from = getArrowEnd(board, fromRef);
+        MinionGraphicsItem *to = getArrowEnd(board, toRef);
+        if(from == nullptr || to == nullptr)    continue;
+
+        //setEnd convierte minionAttack en heroAttack si sale de un heroe
+        ArrowGraphicsItem::ArrowType type = static_cast<ArrowGraphicsItem::ArrowType>(arrowType);
+        ArrowGraphicsItem *arrow = new ArrowGraphicsItem(type==ArrowGraphicsItem::heroAttack?ArrowGraphicsItem::minionAttack:type);
+        arrow->setEnd(true, from);
+        arrow->setEnd(false, to);
+        for(int j=1; j<numAttacks; j++)     arrow->increaseNumAttacks();
+        board->arrows.append(arrow);
+    }
+
+    board->state.clear();
+
+    for(QMap<int, QString>::const_iterator it = board->revealedEnemyCards.cbegin(); it != board->revealedEnemyCards.cend(); it++)
+    {
+        CardGraphicsItem *card = findCard(false, it.key(), board);
+        if(card != nullptr)     card->changeCode(it.value());
+    }
+    board->revealedEnemyCards.clear();
+}
+
+
+//Compacta los turn boards materializados que sobran, nunca el que se ve ni el ultimo turno.
+void PlanHandler::trimExpandedBoards()
+{
+    Board *lastBoard = turnBoards.isEmpty()?nullptr:turnBoards.last();
+    for(int i=expandedTurnBoards.count()-1; i>=0 && expandedTurnBoards.count()>MAX_EXPANDED_TURN_BOARDS; i--)
+    {
+        Board *board = expandedTurnBoards[i];
+        if(board != viewBoard && board != lastBoard)    compactBoard(board);
+    }
+}
+
+
+//El ultimo turno recibe correcciones (addons, tag changes...) despues de guardarse.
+Board * PlanHandler::getLastTurnBoard()
+{
+    Board *board = turnBoards.last();
+    expandBoard(board);
+    trimExpandedBoards();
+    return board;
+}
+
+
 //Evita addons provocado por ocultar/aparecer el arma al final del turno
 void PlanHandler::resetLastPowerAddon()
 {
@@ -1865,31 +2041,35 @@ void PlanHandler::setLastTriggerId(QString code, QString blockType, int id, int
 
 void PlanHandler::redrawDownloadedCardImage(QString code)
 {
-    foreach(MinionGraphicsItem * minion, viewBoard->playerMinions)
-    {
-        minion->checkDownloadedCode(code);
-    }
-    foreach(MinionGraphicsItem * minion, viewBoard->enemyMinions)
-    {
-        minion->checkDownloadedCode(code);
-    }
-    foreach(CardGraphicsItem * card, viewBoard->playerHandList)
+    //Los turnos que no se ven tambien guardan su pintado en cache
+    foreach(Board *board, getAllBoards())
     {
-        card->checkDownloadedCode(code);
-    }
-    foreach(CardGraphicsItem * card, viewBoard->enemyHandList)
-    {
-        card->checkDownloadedCode(code);
-    }
+        foreach(MinionGraphicsItem * minion, board->playerMinions)
+        {
+            minion->checkDownloadedCode(code);
+        }
+        foreach(MinionGraphicsItem * minion, board->enemyMinions)
+        {
+            minion->checkDownloadedCode(code);
+        }
+        foreach(CardGraphicsItem * card, board->playerHandList)
+        {
+            card->checkDownloadedCode(code);
+        }
+        foreach(CardGraphicsItem * card, board->enemyHandList)
+        {
+            card->checkDownloadedCode(code);
+        }
 
-    if(viewBoard->playerHero != nullptr)   viewBoard->playerHero->checkDownloadedCode(code);
-    if(viewBoard->enemyHero != nullptr)    viewBoard->enemyHero->checkDownloadedCode(code);
+        if(board->playerHero != nullptr)   board->playerHero->checkDownloadedCode(code);
+        if(board->enemyHero != nullptr)    board->enemyHero->checkDownloadedCode(code);
 
-    if(viewBoard->playerHeroPower != nullptr)  viewBoard->playerHeroPower->checkDownloadedCode(code);
-    if(viewBoard->enemyHeroPower != nullptr)   viewBoard->enemyHeroPower->checkDownloadedCode(code);
+        if(board->playerHeroPower != nullptr)  board->playerHeroPower->checkDownloadedCode(code);
+        if(board->enemyHeroPower != nullptr)   board->enemyHeroPower->checkDownloadedCode(code);
 
-    if(viewBoard->playerWeapon != nullptr) viewBoard->playerWeapon->checkDownloadedCode(code);
-    if(viewBoard->enemyWeapon != nullptr)  viewBoard->enemyWeapon->checkDownloadedCode(code);
+        if(board->playerWeapon != nullptr) board->playerWeapon->checkDownloadedCode(code);
+        if(board->enemyWeapon != nullptr)  board->enemyWeapon->checkDownloadedCode(code);
+    }
 }
 
 
@@ -2317,6 +2497,7 @@ void PlanHandler::reset()
         resetBoard(board);
         delete board;
     }
+    expandedTurnBoards.clear();
 
     updateTurnSliderRange();
 
@@ -2344,6 +2525,12 @@ void PlanHandler::setTheme()
     ui->planLabelTurn->setFixedWidth(textWide);
 
     ui->planGraphicsView->setTheme(false);
+
+    //Invalida el pintado cacheado de los items con las fuentes anteriores
+    foreach(Board *board, getAllBoards())
+    {
+        foreach(QGraphicsItem *item, getBoardItems(board))  item->update();
+    }
 }
 
 
@@ -2389,7 +2576,12 @@ void PlanHandler::showSliderTurn(int turn)
 {
     int lastTurn = firstStoredTurn + turnBoards.count() - 1;
     if(turn > lastTurn)     viewBoard = nowBoard;
-    else                    viewBoard = turnBoards[turn-firstStoredTurn];
+    else
+    {
+        viewBoard = turnBoards[turn-firstStoredTurn];
+        expandBoard(viewBoard);
+    }
+    trimExpandedBoards();
 
     loadViewBoard();
 
@@ -2435,47 +2627,61 @@ void PlanHandler::showNextTurn()
 }
 
 
+//Solo se quitan/anaden a la escena los items que cambian entre viewBoard y la escena actual.
+//Cada item guarda su propio pintado (DeviceCoordinateCache), asi que volver a un turno ya visto
+//no repinta sus minions/cartas salvo que hayan cambiado (update() invalida su cache).
 void PlanHandler::loadViewBoard()
 {
-    ui->planGraphicsView->removeAll();
-    ui->planGraphicsView->updateView(std::max(viewBoard->playerMinions.count(), viewBoard->enemyMinions.count()));
-    updateViewCardZoneSpots();
+    QGraphicsScene *scene = ui->planGraphicsView->scene();
+    const QList<QGraphicsItem *> boardItems = getBoardItems(viewBoard);
+    const QSet<QGraphicsItem *> boardItemsSet = boardItems.toSet();
 
-    foreach(MinionGraphicsItem *minion, viewBoard->playerMinions)
+    foreach(QGraphicsItem *item, scene->items())
     {
-        ui->planGraphicsView->scene()->addItem(minion);
+        if(item->parentItem() == nullptr && !boardItemsSet.contains(item))  scene->removeItem(item);
     }
 
-    foreach(MinionGraphicsItem *minion, viewBoard->enemyMinions)
-    {
-        ui->planGraphicsView->scene()->addItem(minion);
-    }
+    ui->planGraphicsView->updateView(std::max(viewBoard->playerMinions.count(), viewBoard->enemyMinions.count()));
+    updateViewCardZoneSpots();
 
-    foreach(ArrowGraphicsItem *arrow, viewBoard->arrows)
+    foreach(QGraphicsItem *item, boardItems)
     {
-        ui->planGraphicsView->scene()->addItem(arrow);
+        if(item->scene() != scene)  scene->addItem(item);
     }
 
-    foreach(CardGraphicsItem *card, viewBoard->playerHandList)
-    {
-        ui->planGraphicsView->scene()->addItem(card);
-    }
+    updateTurnLabel();
+}
 
-    foreach(CardGraphicsItem *card, viewBoard->enemyHandList)
-    {
-        ui->planGraphicsView->scene()->addItem(card);
-    }
 
-    if(viewBoard->playerHeroPower != nullptr)  ui->planGraphicsView->scene()->addItem(viewBoard->playerHeroPower);
-    if(viewBoard->enemyHeroPower != nullptr)   ui->planGraphicsView->scene()->addItem(viewBoard->enemyHeroPower);
+//Items de board en el orden en que se anaden a la escena.
+QList<QGraphicsItem *> PlanHandler::getBoardItems(Board *board)
+{
+    QList<QGraphicsItem *> items;
+    foreach(MinionGraphicsItem *minion, board->playerMinions)   items.append(minion);
+    foreach(MinionGraphicsItem *minion, board->enemyMinions)    items.append(minion);
+    foreach(ArrowGraphicsItem *arrow, board->arrows)            items.append(arrow);
+    foreach(CardGraphicsItem *card, board->playerHandList)      items.append(card);
+    foreach(CardGraphicsItem *card, board->enemyHandList)       items.append(card);
 
-    if(viewBoard->playerWeapon != nullptr) ui->planGraphicsView->scene()->addItem(viewBoard->playerWeapon);
-    if(viewBoard->enemyWeapon != nullptr)  ui->planGraphicsView->scene()->addItem(viewBoard->enemyWeapon);
+    if(board->playerHeroPower != nullptr)   items.append(board->playerHeroPower);
+    if(board->enemyHeroPower != nullptr)    items.append(board->enemyHeroPower);
 
-    if(viewBoard->playerHero != nullptr)    ui->planGraphicsView->scene()->addItem(viewBoard->playerHero);
-    if(viewBoard->enemyHero != nullptr)     ui->planGraphicsView->scene()->addItem(viewBoard->enemyHero);
+    if(board->playerWeapon != nullptr)      items.append(board->playerWeapon);
+    if(board->enemyWeapon != nullptr)       items.append(board->enemyWeapon);
 
-    updateTurnLabel();
+    if(board->playerHero != nullptr)        items.append(board->playerHero);
+    if(board->enemyHero != nullptr)         items.append(board->enemyHero);
+
+    return items;
+}
+
+
+QList<Board *> PlanHandler::getAllBoards()
+{
+    QList<Board *> boards = turnBoards;
+    boards.append(nowBoard);
+    if(futureBoard != nullptr)  boards.append(futureBoard);
+    return boards;
 }
 
 
@@ -2514,7 +2720,7 @@ void PlanHandler::addHeroDeadToLastTurn(bool playerWon)
 
     if(turnBoards.empty())  return;
 
-    Board *board = turnBoards.last();
+    Board *board = getLastTurnBoard();
 
     if(playerWon)
     {
@@ -2652,7 +2858,7 @@ void PlanHandler::checkBomb(QString code)
     }
 
     //Get dead probs
-    futureBombs.setFuture(QtConcurrent::run(this, &PlanHandler::bombDeads, targets, missiles));
+    futureBombs.setFuture(QtConcurrent::run(&BombProbabilities::getDeadProbs, targets, missiles));
     abortFutureBombs = false;
 }
 
@@ -2678,80 +2884,6 @@ void PlanHandler::setDeadProbs()
 }
 
 
-QList<float> PlanHandler::bombDeads(QList<int> targets, int missiles)
-{
-    QMap<QString, float> states;
-    states[encodeBombState(targets)] = 1;
-    for(int i=0; i<missiles; i++)           states = bomb(states);
-
-    QList<float> deadProbs;
-    for(int i=0; i<targets.count(); i++)    deadProbs.append(0);
-
-    foreach(QString state, states.keys())
-    {
-        float prob = states[state];
-        QList<int> targets = decodeBombState(state);
-        for(int i=0; i<targets.count(); i++)
-        {
-            if(targets[i] == 0)     deadProbs[i] += prob;
-        }
-    }
-
-    return deadProbs;
-}
-
-
-QList<int> PlanHandler::decodeBombState(QString state)
-{
-    QList<int> targets;
-    foreach(QString targetString, state.split(":"))  targets.append(targetString.toInt());
-    return targets;
-}
-
-
-QString PlanHandler::encodeBombState(QList<int> targets)
-{
-    QStringList targetsString;
-    foreach(int target, targets)      targetsString.append(QString::number(target));
-    return targetsString.join(":");
-}
-
-
-QMap<QString, float> PlanHandler::bomb(QMap<QString, float> &oldStates)
-{
-    QMap<QString, float> newStates;
-
-    foreach(QString oldState, oldStates.keys())
-    {
-        float oldProb = oldStates[oldState];
-        QList<int> oldTargets = decodeBombState(oldState);
-
-        int livingTargets = 0;
-        for(int i=0; i<oldTargets.count(); i++)
-        {
-            if(oldTargets[i] > 0)   livingTargets++;
-        }
-
-        //Apply an attack to each living targets
-        for(int i=0; i<oldTargets.count(); i++)
-        {
-            if(oldTargets[i] > 0)
-            {
-                QList<int> newTargets(oldTargets);
-                newTargets[i]--;
-                QString newState = encodeBombState(newTargets);
-
-                //Update probabilities
-                float addProb = newStates.contains(newState)?newStates[newState]:0;
-                newStates[newState] = addProb + oldProb/livingTargets;
-            }
-        }
-    }
-
-    return newStates;
-}
-
-
 int PlanHandler::flamewakersOnBoard()
 {
     int num = 0;
@@ -2857,8 +2989,11 @@ QJsonArray PlanHandler::getJsonCardHistory()
 {
     QJsonArray cardHistory;
 
-    for(const Board *board: turnBoards)
+    for(Board *board: turnBoards)
     {
+        expandBoard(board);
+        trimExpandedBoards();
+
         QJsonObject item;
         item[ "turn" ] = (board->numTurn + 1)/2;
         item[ "player" ] = board->playerTurn?"me":"opponent";
@@ -11,9 +11,12 @@
 #include "Widgets/GraphicItems/graphicsitemsender.h"
 #include "Cards/handcard.h"
 #include "utility.h"
+#include "Utils/bombprobabilities.h"
 #include <QObject>
 #include <QFutureWatcher>
 
+#define MAX_EXPANDED_TURN_BOARDS    4   //Turn boards con sus items materializados a la vez (ademas del ultimo turno)
+
 
 class TagChange
 {
@@ -46,6 +49,8 @@ public:
     QList<CardGraphicsItem *> enemyHandList;
     bool playerTurn;
     int numTurn = 0;//0 --> nowBoard
+    QByteArray state;//Board compacto: items guardados con saveState y sin materializar
+    QMap<int, QString> revealedEnemyCards;//Cartas enemigas desveladas mientras el board estaba compacto
 };
 
 
@@ -64,6 +69,7 @@ private:
     Board *viewBoard;
     Board *futureBoard;
     QList<Board *> turnBoards;
+    QList<Board *> expandedTurnBoards;//Turn boards materializados, el mas reciente primero
     int firstStoredTurn;// 0 unset
     MinionGraphicsItem * lastMinionAdded;
     MinionGraphicsItem * selectedMinion;
@@ -111,6 +117,8 @@ private:
     void resetBoard(Board *board);
     void updateTurnLabel();
     void loadViewBoard();
+    QList<QGraphicsItem *> getBoardItems(Board *board);
+    QList<Board *> getAllBoards();
     void completeUI();
     bool findAttackPoint(ArrowGraphicsItem *attack, bool isFrom, int id, Board *board);
     bool appendAttack(ArrowGraphicsItem *attack, Board *board);
@@ -145,15 +153,19 @@ private:
     void cardTagChangePrevTurn(int id, bool friendly, QString tag, QString value);
     bool updateInPendingTagChange(int id, QString tag, QString value);
     void createGraphicsItemSender();
-    QMap<QString, float> bomb(QMap<QString, float> &oldStates);
-    QList<int> decodeBombState(QString state);
-    QString encodeBombState(QList<int> targets);
-    QList<float> bombDeads(QList<int> targets, int missiles);
     bool isCardBomb(QString code, bool &playerIn, int &missiles);
     bool isMechOnBoard();
     int flamewakersOnBoard();
     void updateTurnSliderRange();
     Board *copyBoard(Board *origBoard, int numTurn = 0, bool copySecretCodes=false);
+    Board *compactBoardCopy(Board *origBoard, int numTurn);
+    void saveBoardState(Board *board, QDataStream &stream, bool saveSecretCodes, bool asCopy);
+    void compactBoard(Board *board);
+    void expandBoard(Board *board);
+    void trimExpandedBoards();
+    Board *getLastTurnBoard();
+    int getArrowEndRef(Board *board, MinionGraphicsItem *item);
+    MinionGraphicsItem *getArrowEnd(Board *board, int ref);
     void deleteFutureBoard();
     void createFutureBoard();
     void updateMinionFromCard(MinionGraphicsItem *minion);
@@ -214,6 +214,7 @@ void SynergyHandler::initSynergyCodes()
 {
     synergyCodes.clear();
     directLinks.clear();
+    synergyFlags.clear();
 
     QFile jsonFile(Utility::extraPath() + "/synergies.json");
     jsonFile.open(QIODevice::ReadOnly | QIODevice::Text);
@@ -254,10 +255,217 @@ void SynergyHandler::initSynergyCodes()
 }
 
 
+void SynergyHandler::clearSynergyFlags()
+{
+    synergyFlags.clear();
+}
+
+
+const SynergyFlags &SynergyHandler::getSynergyFlags(const QString &code)
+{
+    QHash<QString, SynergyFlags>::const_iterator it = synergyFlags.constFind(code);
+    if(it == synergyFlags.cend())   it = synergyFlags.insert(code, computeSynergyFlags(code));
+    return it.value();
+}
+
+
+//Evalua una sola vez todos los isXxxGen/isXxxSyn de la carta.
+//synergyFlags se vacia en initSynergyCodes, clearLists y clearSynergyFlags (cards.json nuevo).
+SynergyFlags SynergyHandler::computeSynergyFlags(const QString &code)
+{
+    SynergyFlags flags;
+    flags.raceGen.resize(V_NUM_RACES);
+    flags.raceSyn.resize(V_NUM_RACES);
+    flags.typeGen.resize(V_NUM_TYPES);
+    flags.typeSyn.resize(V_NUM_TYPES);
+    flags.mechanicGen.resize(V_NUM_MECHANICS);
+    flags.mechanicSyn.resize(V_NUM_MECHANICS);
+
+    DeckCard deckCard(code);
+    QJsonArray mechanics = Utility::getCardAttribute(code, "mechanics").toArray();
+    QJsonArray referencedTags = Utility::getCardAttribute(code, "referencedTags").toArray();
+    QString text = Utility::cardEnTextLowerFromCode(code);
+    CardType cardType = deckCard.getType();
+    CardRace cardRace = deckCard.getRace();
+    int attack = Utility::getCardAttribute(code, "attack").toInt();
+    int cost = deckCard.getCost();
+
+    //RACE
+    if(cardRace == MURLOC)          {flags.raceGen.setBit(V_MURLOC); flags.raceGen.setBit(V_MURLOC_ALL);}
+    else if(isMurlocGen(code))      flags.raceGen.setBit(V_MURLOC_ALL);
+    if(cardRace == DEMON)           {flags.raceGen.setBit(V_DEMON); flags.raceGen.setBit(V_DEMON_ALL);}
+    else if(isDemonGen(code))       flags.raceGen.setBit(V_DEMON_ALL);
+    if(cardRace == MECHANICAL)      {flags.raceGen.setBit(V_MECHANICAL); flags.raceGen.setBit(V_MECHANICAL_ALL);}
+    else if(isMechGen(code))        flags.raceGen.setBit(V_MECHANICAL_ALL);
+    if(cardRace == ELEMENTAL)       {flags.raceGen.setBit(V_ELEMENTAL); flags.raceGen.setBit(V_ELEMENTAL_ALL);}
+    else if(isElementalGen(code))   flags.raceGen.setBit(V_ELEMENTAL_ALL);
+    if(cardRace == BEAST)           {flags.raceGen.setBit(V_BEAST); flags.raceGen.setBit(V_BEAST_ALL);}
+    else if(isBeastGen(code))       flags.raceGen.setBit(V_BEAST_ALL);
+    if(cardRace == TOTEM)           {flags.raceGen.setBit(V_TOTEM); flags.raceGen.setBit(V_TOTEM_ALL);}
+    else if(isTotemGen(code))       flags.raceGen.setBit(V_TOTEM_ALL);
+    if(cardRace == PIRATE)          {flags.raceGen.setBit(V_PIRATE); flags.raceGen.setBit(V_PIRATE_ALL);}
+    else if(isPirateGen(code))      flags.raceGen.setBit(V_PIRATE_ALL);
+    if(cardRace == DRAGON)          {flags.raceGen.setBit(V_DRAGON); flags.raceGen.setBit(V_DRAGON_ALL);}
+    else if(isDragonGen(code))      flags.raceGen.setBit(V_DRAGON_ALL);
+
+    if(isMurlocSyn(code))                           flags.raceSyn.setBit(V_MURLOC);
+    else if(isMurlocAllSyn(code, text))             flags.raceSyn.setBit(V_MURLOC_ALL);
+    if(isDemonSyn(code))                            flags.raceSyn.setBit(V_DEMON);
+    else if(isDemonAllSyn(code, text))              flags.raceSyn.setBit(V_DEMON_ALL);
+    if(isMechSyn(code))                             flags.raceSyn.setBit(V_MECHANICAL);
+    else if(isMechAllSyn(code, mechanics, text))    flags.raceSyn.setBit(V_MECHANICAL_ALL);
+    if(isElementalSyn(code))                        flags.raceSyn.setBit(V_ELEMENTAL);
+    else if(isElementalAllSyn(code, text))          flags.raceSyn.setBit(V_ELEMENTAL_ALL);
+    if(isBeastSyn(code))                            flags.raceSyn.setBit(V_BEAST);
+    else if(isBeastAllSyn(code, text))              flags.raceSyn.setBit(V_BEAST_ALL);
+    if(isTotemSyn(code))                            flags.raceSyn.setBit(V_TOTEM);
+    else if(isTotemAllSyn(code, text))              flags.raceSyn.setBit(V_TOTEM_ALL);
+    if(isPirateSyn(code))                           flags.raceSyn.setBit(V_PIRATE);
+    else if(isPirateAllSyn(code, text))             flags.raceSyn.setBit(V_PIRATE_ALL);
+    if(isDragonSyn(code, text))                     flags.raceSyn.setBit(V_DRAGON);
+    else if(isDragonAllSyn(code))                   flags.raceSyn.setBit(V_DRAGON_ALL);
+
+    //CARD TYPE
+    if(cardType == SPELL)                   {flags.typeGen.setBit(V_SPELL); flags.typeGen.setBit(V_SPELL_ALL);}
+    else if(isSpellGen(code))               flags.typeGen.setBit(V_SPELL_ALL);
+    if(cardType == MINION || cardType == HERO)  flags.typeGen.setBit(V_MINION);
+    if(cardType == WEAPON)                  {flags.typeGen.setBit(V_WEAPON); flags.typeGen.setBit(V_WEAPON_ALL);}
+    else if(isWeaponGen(code, text))        flags.typeGen.setBit(V_WEAPON_ALL);
+
+    if(isSpellSyn(code))                    flags.typeSyn.setBit(V_SPELL);
+    else if(isSpellAllSyn(code, text))      flags.typeSyn.setBit(V_SPELL_ALL);
+    if(isWeaponSyn(code))                   flags.typeSyn.setBit(V_WEAPON);
+    else if(isWeaponAllSyn(code, text))     flags.typeSyn.setBit(V_WEAPON_ALL);
+
+    //MECHANICS GEN
+    flags.discover = numDiscoverGen(code, mechanics, referencedTags);
+    flags.draw = numDrawGen(code, text);
+    flags.toYourHand = numToYourHandGen(code, text);
+    QBitArray &gen = flags.mechanicGen;
+    if(flags.discover > 0 || flags.draw > 0 || flags.toYourHand > 0)        gen.setBit(V_DISCOVER_DRAW);
+    if(flags.discover > 0)                                                  gen.setBit(V_DISCOVER);
+    if(flags.draw > 0)                                                      gen.setBit(V_DRAW);
+    if(flags.toYourHand > 0)                                                gen.setBit(V_TOYOURHAND);
+    if(isAoeGen(code, text))                                                gen.setBit(V_AOE);
+    if(isPingGen(code, mechanics, referencedTags, text, cardType, attack))  gen.setBit(V_PING);
+    if(isDamageMinionsGen(code, mechanics, referencedTags, text, cardType, attack)) gen.setBit(V_DAMAGE);
+    if(isDestroyGen(code, mechanics, text))                                 gen.setBit(V_DESTROY);
+    if(isReachGen(code, mechanics, referencedTags, text, cardType, attack)) gen.setBit(V_REACH);
+    if(isRestoreFriendlyHeroGen(code, mechanics, text))                     gen.setBit(V_RESTORE_FRIENDLY_HEROE);
+    if(isArmorGen(code, text))                                              gen.setBit(V_ARMOR);
+    if(gen.testBit(V_RESTORE_FRIENDLY_HEROE) || gen.testBit(V_ARMOR))       gen.setBit(V_SURVIVABILITY);
+    if(isOverload(code))                                                    gen.setBit(V_OVERLOAD);
+    if(isJadeGolemGen(code, mechanics, referencedTags))                     gen.setBit(V_JADE_GOLEM);
+    if(isFreezeEnemyGen(code, mechanics, referencedTags, text))             gen.setBit(V_FREEZE_ENEMY);
+    if(isDiscardGen(code, text))                                            gen.setBit(V_DISCARD);
+    if(isDeathrattleMinion(code, mechanics, cardType))                      gen.setBit(V_DEATHRATTLE);
+    if(isDeathrattleGoodAll(code, mechanics, referencedTags, cardType))     gen.setBit(V_DEATHRATTLE_GOOD_ALL);
+    if(isBattlecry(code, mechanics))                                        gen.setBit(V_BATTLECRY);
+    if(isSilenceOwnGen(code, mechanics, referencedTags))                    gen.setBit(V_SILENCE);
+    if(isTauntGiverGen(code))                                               gen.setBit(V_TAUNT_GIVER);
+    if(isTokenGen(code, text))                                              gen.setBit(V_TOKEN);
+    if(isTokenCardGen(code, cost))                                          gen.setBit(V_TOKEN_CARD);
+    if(isComboGen(code, mechanics))                                         gen.setBit(V_COMBO);
+    if(isWindfuryMinion(code, mechanics, cardType))                         gen.setBit(V_WINDFURY_MINION);
+    if(isAttackBuffGen(code, text))                                         gen.setBit(V_ATTACK_BUFF);
+    if(isHealthBuffGen(code, text))                                         gen.setBit(V_HEALTH_BUFF);
+    if(isReturnGen(code, text))                                             gen.setBit(V_RETURN);
+    if(isStealthGen(code, mechanics))                                       gen.setBit(V_STEALTH);
+    if(isSpellDamageGen(code))                                              gen.setBit(V_SPELL_DAMAGE);
+    if(isEvolveGen(code, text))                                             gen.setBit(V_EVOLVE);
+    if(isSpawnEnemyGen(code, text))                                         gen.setBit(V_SPAWN_ENEMY);
+    if(isRestoreTargetMinionGen(code, text))                                gen.setBit(V_RESTORE_TARGET_MINION);
+    if(isRestoreFriendlyMinionGen(code, text))                              gen.setBit(V_RESTORE_FRIENDLY_MINION);
+    if(isLifestealMinon(code, mechanics, cardType))                         gen.setBit(V_LIFESTEAL_MINION);
+    if(isEnrageGen(code, mechanics))                                        gen.setBit(V_ENRAGED);
+    if(isEggGen(code, mechanics, attack, cardType))                         gen.setBit(V_EGG);
+    if(isDamageFriendlyHeroGen(code))                                       gen.setBit(V_DAMAGE_FRIENDLY_HERO);
+    if(isTaunt(code, mechanics))                    {gen.setBit(V_TAUNT); gen.setBit(V_TAUNT_ALL);}
+    else if(isTauntGen(code, referencedTags))       gen.setBit(V_TAUNT_ALL);
+    if(isDivineShield(code, mechanics))             {gen.setBit(V_DIVINE_SHIELD); gen.setBit(V_DIVINE_SHIELD_ALL);}
+    else if(isDivineShieldGen(code, referencedTags))gen.setBit(V_DIVINE_SHIELD_ALL);
+    if(isSecret(code, mechanics))                   {gen.setBit(V_SECRET); gen.setBit(V_SECRET_ALL);}
+    else if(isSecretGen(code))                      gen.setBit(V_SECRET_ALL);
+    if(isEcho(code, text))                          {gen.setBit(V_ECHO); gen.setBit(V_ECHO_ALL);}
+    else if(isEchoGen(code))                        gen.setBit(V_ECHO_ALL);
+    if(isRush(code, text))                          {gen.setBit(V_RUSH); gen.setBit(V_RUSH_ALL);}
+    else if(isRushGen(code))                        gen.setBit(V_RUSH_ALL);
+    if(isMagnetic(code, mechanics))                 {gen.setBit(V_MAGNETIC); gen.setBit(V_MAGNETIC_ALL);}
+    else if(isMagneticGen(code))                    gen.setBit(V_MAGNETIC_ALL);
+
+    //MECHANICS SYN
+    QBitArray &syn = flags.mechanicSyn;
+    if(isAoeSyn(code))                                                      syn.setBit(V_AOE);
+    if(isPingSyn(code))                                                     syn.setBit(V_PING);
+    if(isDiscoverSyn(code))                                                 syn.setBit(V_DISCOVER);
+    if(isDrawSyn(code))                                                     syn.setBit(V_DRAW);
+    if(isToYourHandSyn(code))                                               syn.setBit(V_TOYOURHAND);
+    if(isOverloadSyn(code, text))                                           syn.setBit(V_OVERLOAD);
+    if(isFreezeEnemySyn(code, referencedTags, text))                        syn.setBit(V_FREEZE_ENEMY);
+    if(isDiscardSyn(code, text))                                            syn.setBit(V_DISCARD);
+    if(isBattlecrySyn(code, referencedTags))                                syn.setBit(V_BATTLECRY);
+    if(isSilenceOwnSyn(code, mechanics))                                    syn.setBit(V_SILENCE);
+    if(isTauntGiverSyn(code, mechanics, attack, cardType))                  syn.setBit(V_TAUNT_GIVER);
+    if(isTokenSyn(code, text))                                              syn.setBit(V_TOKEN);
+    if(isTokenCardSyn(code, text))                                          syn.setBit(V_TOKEN_CARD);
+    if(isComboSyn(code, referencedTags))                                    syn.setBit(V_COMBO);
+    if(isWindfuryMinionSyn(code))                                           syn.setBit(V_WINDFURY_MINION);
+    if(isAttackBuffSyn(code, mechanics, attack, cardType))                  syn.setBit(V_ATTACK_BUFF);
+    if(isHealthBuffSyn(code))                                               syn.setBit(V_HEALTH_BUFF);
+    if(isReturnSyn(code, mechanics, cardType, text))                        syn.setBit(V_RETURN);
+    if(isStealthSyn(code))                                                  syn.setBit(V_STEALTH);
+    if(isSpellDamageSyn(code, mechanics, cardType, text))                   syn.setBit(V_SPELL_DAMAGE);
+    if(isEvolveSyn(code))                                                   syn.setBit(V_EVOLVE);
+    if(isSpawnEnemySyn(code))                                               syn.setBit(V_SPAWN_ENEMY);
+    if(isRestoreTargetMinionSyn(code))                                      syn.setBit(V_RESTORE_TARGET_MINION);
+    if(isRestoreFriendlyHeroSyn(code))                                      syn.setBit(V_RESTORE_FRIENDLY_HEROE);
+    if(isRestoreFriendlyMinionSyn(code))                                    syn.setBit(V_RESTORE_FRIENDLY_MINION);
+    if(isLifestealMinionSyn(code))                                          syn.setBit(V_LIFESTEAL_MINION);
+    if(isArmorSyn(code))                                                    syn.setBit(V_ARMOR);
+    if(isEnrageSyn(code, text))                                             syn.setBit(V_ENRAGED);
+    if(isEggSyn(code, text))                                                syn.setBit(V_EGG);
+    if(isDamageFriendlyHeroSyn(code))                                       syn.setBit(V_DAMAGE_FRIENDLY_HERO);
+    if(isTauntSyn(code))                                                    syn.setBit(V_TAUNT);
+    else if(isTauntAllSyn(code))                                            syn.setBit(V_TAUNT_ALL);
+    if(isDeathrattleSyn(code))                                              syn.setBit(V_DEATHRATTLE);
+    else if(isDeathrattleGoodAllSyn(code))                                  syn.setBit(V_DEATHRATTLE_GOOD_ALL);
+    if(isDivineShieldSyn(code))                                             syn.setBit(V_DIVINE_SHIELD);
+    else if(isDivineShieldAllSyn(code))                                     syn.setBit(V_DIVINE_SHIELD_ALL);
+    if(isSecretSyn(code))                                                   syn.setBit(V_SECRET);
+    else if(isSecretAllSyn(code, referencedTags))                           syn.setBit(V_SECRET_ALL);
+    if(isEchoSyn(code))                                                     syn.setBit(V_ECHO);
+    else if(isEchoAllSyn(code))                                             syn.setBit(V_ECHO_ALL);
+    if(isRushSyn(code))                                                     syn.setBit(V_RUSH);
+    else if(isRushAllSyn(code))                                             syn.setBit(V_RUSH_ALL);
+    if(isMagneticSyn(code))                                                 syn.setBit(V_MAGNETIC);
+    else if(isMagneticAllSyn(code))                                         syn.setBit(V_MAGNETIC_ALL);
+
+    //STATS
+    flags.statSyns = StatSynergies::getStatsSynergiesFromJson(code, synergyCodes);
+    if(cardType == MINION)
+    {
+        flags.statPoints.append(StatSyn{S_COST, S_EQUAL, S_MINION, cost, true});
+        flags.statPoints.append(StatSyn{S_ATTACK, S_EQUAL, S_MINION, attack, true});
+        flags.statPoints.append(StatSyn{S_HEALTH, S_EQUAL, S_MINION, Utility::getCardAttribute(code, "health").toInt(), true});
+    }
+    else if(cardType == SPELL)
+    {
+        flags.statPoints.append(StatSyn{S_COST, S_EQUAL, S_SPELL, cost, true});
+    }
+    for(const StatSyn &statSyn: flags.statSyns)
+    {
+        if(statSyn.isGen)   flags.statPoints.append(statSyn);
+    }
+
+    return flags;
+}
+
+
 void SynergyHandler::clearLists(bool keepCounters)
 {
     synergyCodes.clear();
     directLinks.clear();
+    synergyFlags.clear();
 
     if(!keepCounters)
     {
@@ -412,22 +620,15 @@ int SynergyHandler::getCounters(QStringList &spellList, QStringList &minionList,
     discover = draw = toYourHand = 0;
     for(DeckCard &deckCard: mechanicCounters[V_DISCOVER]->getDeckCardList())
     {
-        QString code = deckCard.getCode();
-        QJsonArray mechanics = Utility::getCardAttribute(code, "mechanics").toArray();
-        QJsonArray referencedTags = Utility::getCardAttribute(code, "referencedTags").toArray();
-        discover += deckCard.total * numDiscoverGen(code, mechanics, referencedTags);
+        discover += deckCard.total * getSynergyFlags(deckCard.getCode()).discover;
     }
     for(DeckCard &deckCard: mechanicCounters[V_DRAW]->getDeckCardList())
     {
-        QString code = deckCard.getCode();
-        QString text = Utility::cardEnTextFromCode(code).toLower();
-        draw += deckCard.total * numDrawGen(code, text);
+        draw += deckCard.total * getSynergyFlags(deckCard.getCode()).draw;
     }
     for(DeckCard &deckCard: mechanicCounters[V_TOYOURHAND]->getDeckCardList())
     {
-        QString code = deckCard.getCode();
-        QString text = Utility::cardEnTextFromCode(code).toLower();
-        toYourHand += deckCard.total * numToYourHandGen(code, text);
+        toYourHand += deckCard.total * getSynergyFlags(deckCard.getCode()).toYourHand;
     }
 
     return manaCounter->count();
@@ -463,109 +664,30 @@ void SynergyHandler::updateManaCounter(DeckCard &deckCard)
 void SynergyHandler::updateRaceCounters(DeckCard &deckCard)
 {
     QString code = deckCard.getCode();
-    QString text = Utility::cardEnTextFromCode(code).toLower();
-    CardRace cardRace = deckCard.getRace();
-    QJsonArray mechanics = Utility::getCardAttribute(code, "mechanics").toArray();
+    const SynergyFlags &flags = getSynergyFlags(code);
 
-    if(cardRace == MURLOC)
-    {
-        raceCounters[V_MURLOC]->increase(code);
-        raceCounters[V_MURLOC_ALL]->increase(code);
-    }
-    else if(isMurlocGen(code))      raceCounters[V_MURLOC_ALL]->increase(code);
-    if(cardRace == DEMON)
-    {
-        raceCounters[V_DEMON]->increase(code);
-        raceCounters[V_DEMON_ALL]->increase(code);
-    }
-    else if(isDemonGen(code))       raceCounters[V_DEMON_ALL]->increase(code);
-    if(cardRace == MECHANICAL)
-    {
-        raceCounters[V_MECHANICAL]->increase(code);
-        raceCounters[V_MECHANICAL_ALL]->increase(code);
-    }
-    else if(isMechGen(code))        raceCounters[V_MECHANICAL_ALL]->increase(code);
-    if(cardRace == ELEMENTAL)
-    {
-        raceCounters[V_ELEMENTAL]->increase(code);
-        raceCounters[V_ELEMENTAL_ALL]->increase(code);
-    }
-    else if(isElementalGen(code))   raceCounters[V_ELEMENTAL_ALL]->increase(code);
-    if(cardRace == BEAST)
-    {
-        raceCounters[V_BEAST]->increase(code);
-        raceCounters[V_BEAST_ALL]->increase(code);
-    }
-    else if(isBeastGen(code))       raceCounters[V_BEAST_ALL]->increase(code);
-    if(cardRace == TOTEM)
-    {
-        raceCounters[V_TOTEM]->increase(code);
-        raceCounters[V_TOTEM_ALL]->increase(code);
-    }
-    else if(isTotemGen(code))       raceCounters[V_TOTEM_ALL]->increase(code);
-    if(cardRace == PIRATE)
-    {
-        raceCounters[V_PIRATE]->increase(code);
-        raceCounters[V_PIRATE_ALL]->increase(code);
-    }
-    else if(isPirateGen(code))      raceCounters[V_PIRATE_ALL]->increase(code);
-    if(cardRace == DRAGON)
+    for(int i=0; i<V_NUM_RACES; i++)
     {
-        raceCounters[V_DRAGON]->increase(code);
-        raceCounters[V_DRAGON_ALL]->increase(code);
+        if(flags.raceGen.testBit(i))    raceCounters[i]->increase(code);
+        if(flags.raceSyn.testBit(i))    raceCounters[i]->increaseSyn(code);
     }
-    else if(isDragonGen(code))      raceCounters[V_DRAGON_ALL]->increase(code);
-
-    if(isMurlocSyn(code))                           raceCounters[V_MURLOC]->increaseSyn(code);
-    else if(isMurlocAllSyn(code, text))             raceCounters[V_MURLOC_ALL]->increaseSyn(code);
-    if(isDemonSyn(code))                            raceCounters[V_DEMON]->increaseSyn(code);
-    else if(isDemonAllSyn(code, text))              raceCounters[V_DEMON_ALL]->increaseSyn(code);
-    if(isMechSyn(code))                             raceCounters[V_MECHANICAL]->increaseSyn(code);
-    else if(isMechAllSyn(code, mechanics, text))    raceCounters[V_MECHANICAL_ALL]->increaseSyn(code);
-    if(isElementalSyn(code))                        raceCounters[V_ELEMENTAL]->increaseSyn(code);
-    else if(isElementalAllSyn(code, text))          raceCounters[V_ELEMENTAL_ALL]->increaseSyn(code);
-    if(isBeastSyn(code))                            raceCounters[V_BEAST]->increaseSyn(code);
-    else if(isBeastAllSyn(code, text))              raceCounters[V_BEAST_ALL]->increaseSyn(code);
-    if(isTotemSyn(code))                            raceCounters[V_TOTEM]->increaseSyn(code);
-    else if(isTotemAllSyn(code, text))              raceCounters[V_TOTEM_ALL]->increaseSyn(code);
-    if(isPirateSyn(code))                           raceCounters[V_PIRATE]->increaseSyn(code);
-    else if(isPirateAllSyn(code, text))             raceCounters[V_PIRATE_ALL]->increaseSyn(code);
-    if(isDragonSyn(code, text))                     raceCounters[V_DRAGON]->increaseSyn(code);
-    else if(isDragonAllSyn(code))                   raceCounters[V_DRAGON_ALL]->increaseSyn(code);
 }
 
 
 void SynergyHandler::updateCardTypeCounters(DeckCard &deckCard, QStringList &spellList, QStringList &minionList, QStringList &weaponList)
 {
     QString code = deckCard.getCode();
-    QString text = Utility::cardEnTextFromCode(code).toLower();
-    CardType cardType = deckCard.getType();
+    const SynergyFlags &flags = getSynergyFlags(code);
 
-    if(cardType == SPELL)
-    {
-        cardTypeCounters[V_SPELL]->increase(code);
-        cardTypeCounters[V_SPELL_ALL]->increase(code);
-        spellList.append(code);
-    }
-    else if(isSpellGen(code))           cardTypeCounters[V_SPELL_ALL]->increase(code);
-    if(cardType == MINION || cardType == HERO)
-    {
-        cardTypeCounters[V_MINION]->increase(code);
-        minionList.append(code);
-    }
-    if(cardType == WEAPON)
+    for(int i=0; i<V_NUM_TYPES; i++)
     {
-        cardTypeCounters[V_WEAPON]->increase(code);
-        cardTypeCounters[V_WEAPON_ALL]->increase(code);
-        weaponList.append(code);
+        if(flags.typeGen.testBit(i))    cardTypeCounters[i]->increase(code);
+        if(flags.typeSyn.testBit(i))    cardTypeCounters[i]->increaseSyn(code);
     }
-    else if(isWeaponGen(code, text))    cardTypeCounters[V_WEAPON_ALL]->increase(code);
-
 
-    if(isSpellSyn(code))                cardTypeCounters[V_SPELL]->increaseSyn(code);
-    else if(isSpellAllSyn(code, text))  cardTypeCounters[V_SPELL_ALL]->increaseSyn(code);
-    if(isWeaponSyn(code))               cardTypeCounters[V_WEAPON]->increaseSyn(code);
-    else if(isWeaponAllSyn(code, text)) cardTypeCounters[V_WEAPON_ALL]->increaseSyn(code);
+    if(flags.typeGen.testBit(V_SPELL))  spellList.append(code);
+    if(flags.typeGen.testBit(V_MINION)) minionList.append(code);
+    if(flags.typeGen.testBit(V_WEAPON)) weaponList.append(code);
 }
 
 
@@ -574,184 +696,28 @@ void SynergyHandler::updateMechanicCounters(DeckCard &deckCard,
                                             QStringList &pingList, QStringList &damageList, QStringList &destroyList, QStringList &reachList,
                                             int &draw, int &toYourHand, int &discover)
 {
-    bool isSurvivability = false;
     QString code = deckCard.getCode();
-    QJsonArray mechanics = Utility::getCardAttribute(code, "mechanics").toArray();
-    QJsonArray referencedTags = Utility::getCardAttribute(code, "referencedTags").toArray();
-    QString text = Utility::cardEnTextFromCode(code).toLower();
-    CardType cardType = deckCard.getType();
-    int attack = Utility::getCardAttribute(code, "attack").toInt();
-//    int cost = deckCard.getCost();
+    const SynergyFlags &flags = getSynergyFlags(code);
 
-    //GEN
-    if(isDiscoverDrawGen(code, mechanics, referencedTags, text))
-    {
-        mechanicCounters[V_DISCOVER_DRAW]->increase(code);
-        drawList.append(code);
-    }
-    if(isAoeGen(code, text))
-    {
-        mechanicCounters[V_AOE]->increase(code);
-        aoeList.append(code);
-    }
-    if(isPingGen(code, mechanics, referencedTags, text, cardType, attack))
-    {
-        mechanicCounters[V_PING]->increase(code);
-        pingList.append(code);
-    }
-    if(isDamageMinionsGen(code, mechanics, referencedTags, text, cardType, attack))
-    {
-        mechanicCounters[V_DAMAGE]->increase(code);
-        damageList.append(code);
-    }
-    if(isDestroyGen(code, mechanics, text))
-    {
-        mechanicCounters[V_DESTROY]->increase(code);
-        destroyList.append(code);
-    }
-    if(isReachGen(code, mechanics, referencedTags, text, cardType, attack))
-    {
-        mechanicCounters[V_REACH]->increase(code);
-        reachList.append(code);
-    }
-    if(isRestoreFriendlyHeroGen(code, mechanics, text))
-    {
-        mechanicCounters[V_RESTORE_FRIENDLY_HEROE]->increase(code);
-        isSurvivability = true;
-    }
-    if(isArmorGen(code, text))
-    {
-        mechanicCounters[V_ARMOR]->increase(code);
-        isSurvivability = true;
-    }
-    if(isSurvivability)
-    {
-        mechanicCounters[V_SURVIVABILITY]->increase(code);
-        survivabilityList.append(code);
-    }
-    discover = numDiscoverGen(code, mechanics, referencedTags);
-    draw = numDrawGen(code, text);
-    toYourHand = numToYourHandGen(code, text);
-    if(discover > 0)                                                        mechanicCounters[V_DISCOVER]->increase(code);
-    if(draw > 0)                                                            mechanicCounters[V_DRAW]->increase(code);
-    if(toYourHand > 0)                                                      mechanicCounters[V_TOYOURHAND]->increase(code);
-    if(isOverload(code))                                                    mechanicCounters[V_OVERLOAD]->increase(code);
-    if(isJadeGolemGen(code, mechanics, referencedTags))                     mechanicCounters[V_JADE_GOLEM]->increase(code);
-    if(isFreezeEnemyGen(code, mechanics, referencedTags, text))             mechanicCounters[V_FREEZE_ENEMY]->increase(code);
-    if(isDiscardGen(code, text))                                            mechanicCounters[V_DISCARD]->increase(code);
-    if(isDeathrattleMinion(code, mechanics, cardType))                      mechanicCounters[V_DEATHRATTLE]->increase(code);
-    if(isDeathrattleGoodAll(code, mechanics, referencedTags, cardType))     mechanicCounters[V_DEATHRATTLE_GOOD_ALL]->increase(code);
-    if(isBattlecry(code, mechanics))                                        mechanicCounters[V_BATTLECRY]->increase(code);
-    if(isSilenceOwnGen(code, mechanics, referencedTags))                    mechanicCounters[V_SILENCE]->increase(code);
-    if(isTauntGiverGen(code))                                               mechanicCounters[V_TAUNT_GIVER]->increase(code);
-    if(isTokenGen(code, text))                                              mechanicCounters[V_TOKEN]->increase(code);
-    //TokenCard es synergia debil
-    //Evitamos que aparezcan token cards synergies en cada combo card
-//    if(isTokenCardGen(code, cost))                                          mechanicCounters[V_TOKEN_CARD]->increase(code);
-    if(isComboGen(code, mechanics))                                         mechanicCounters[V_COMBO]->increase(code);
-    if(isWindfuryMinion(code, mechanics, cardType))                         mechanicCounters[V_WINDFURY_MINION]->increase(code);
-    if(isAttackBuffGen(code, text))                                         mechanicCounters[V_ATTACK_BUFF]->increase(code);
-    if(isHealthBuffGen(code, text))                                         mechanicCounters[V_HEALTH_BUFF]->increase(code);
-    if(isReturnGen(code, text))                                             mechanicCounters[V_RETURN]->increase(code);
-    if(isStealthGen(code, mechanics))                                       mechanicCounters[V_STEALTH]->increase(code);
-    if(isSpellDamageGen(code))                                              mechanicCounters[V_SPELL_DAMAGE]->increase(code);
-    if(isEvolveGen(code, text))                                             mechanicCounters[V_EVOLVE]->increase(code);
-    if(isSpawnEnemyGen(code, text))                                         mechanicCounters[V_SPAWN_ENEMY]->increase(code);
-    if(isRestoreTargetMinionGen(code, text))                                mechanicCounters[V_RESTORE_TARGET_MINION]->increase(code);
-    if(isRestoreFriendlyMinionGen(code, text))                              mechanicCounters[V_RESTORE_FRIENDLY_MINION]->increase(code);
-    if(isLifestealMinon(code, mechanics, cardType))                         mechanicCounters[V_LIFESTEAL_MINION]->increase(code);
-    if(isEnrageGen(code, mechanics))                                        mechanicCounters[V_ENRAGED]->increase(code);
-    if(isEggGen(code, mechanics, attack, cardType))                         mechanicCounters[V_EGG]->increase(code);
-    if(isDamageFriendlyHeroGen(code))                                       mechanicCounters[V_DAMAGE_FRIENDLY_HERO]->increase(code);
-    if(isTaunt(code, mechanics))
-    {
-        mechanicCounters[V_TAUNT]->increase(code);
-        mechanicCounters[V_TAUNT_ALL]->increase(code);
-        tauntList.append(code);
-    }
-    else if(isTauntGen(code, referencedTags))
-    {
-        mechanicCounters[V_TAUNT_ALL]->increase(code);
-        tauntList.append(code);
-    }
-    if(isDivineShield(code, mechanics))
-    {
-        mechanicCounters[V_DIVINE_SHIELD]->increase(code);
-        mechanicCounters[V_DIVINE_SHIELD_ALL]->increase(code);
-    }
-    else if(isDivineShieldGen(code, referencedTags))                        mechanicCounters[V_DIVINE_SHIELD_ALL]->increase(code);
-    if(isSecret(code, mechanics))
-    {
-        mechanicCounters[V_SECRET]->increase(code);
-        mechanicCounters[V_SECRET_ALL]->increase(code);
-    }
-    else if(isSecretGen(code))                                              mechanicCounters[V_SECRET_ALL]->increase(code);
-    if(isEcho(code, text))
-    {
-        mechanicCounters[V_ECHO]->increase(code);
-        mechanicCounters[V_ECHO_ALL]->increase(code);
-    }
-    else if(isEchoGen(code))                                                mechanicCounters[V_ECHO_ALL]->increase(code);
-    if(isRush(code, text))
-    {
-        mechanicCounters[V_RUSH]->increase(code);
-        mechanicCounters[V_RUSH_ALL]->increase(code);
-    }
-    else if(isRushGen(code))                                                mechanicCounters[V_RUSH_ALL]->increase(code);
-    if(isMagnetic(code, mechanics))
+    for(int i=0; i<V_NUM_MECHANICS; i++)
     {
-        mechanicCounters[V_MAGNETIC]->increase(code);
-        mechanicCounters[V_MAGNETIC_ALL]->increase(code);
+        //TokenCard es synergia debil
+        //Evitamos que aparezcan token cards synergies en cada combo card
+        if(flags.mechanicGen.testBit(i) && i != V_TOKEN_CARD)   mechanicCounters[i]->increase(code);
+        if(flags.mechanicSyn.testBit(i))                        mechanicCounters[i]->increaseSyn(code);
     }
-    else if(isMagneticGen(code))                                            mechanicCounters[V_MAGNETIC_ALL]->increase(code);
 
-
-
-    //SYN
-    if(isAoeSyn(code))                                                      mechanicCounters[V_AOE]->increaseSyn(code);
-    if(isPingSyn(code))                                                     mechanicCounters[V_PING]->increaseSyn(code);
-    if(isDiscoverSyn(code))                                                 mechanicCounters[V_DISCOVER]->increaseSyn(code);
-    if(isDrawSyn(code))                                                     mechanicCounters[V_DRAW]->increaseSyn(code);
-    if(isToYourHandSyn(code))                                               mechanicCounters[V_TOYOURHAND]->increaseSyn(code);
-    if(isOverloadSyn(code, text))                                           mechanicCounters[V_OVERLOAD]->increaseSyn(code);
-    if(isFreezeEnemySyn(code, referencedTags, text))                        mechanicCounters[V_FREEZE_ENEMY]->increaseSyn(code);
-    if(isDiscardSyn(code, text))                                            mechanicCounters[V_DISCARD]->increaseSyn(code);
-    if(isBattlecrySyn(code, referencedTags))                                mechanicCounters[V_BATTLECRY]->increaseSyn(code);
-    if(isSilenceOwnSyn(code, mechanics))                                    mechanicCounters[V_SILENCE]->increaseSyn(code);
-    if(isTauntGiverSyn(code, mechanics, attack, cardType))                  mechanicCounters[V_TAUNT_GIVER]->increaseSyn(code);
-    if(isTokenSyn(code, text))                                              mechanicCounters[V_TOKEN]->increaseSyn(code);
-    if(isTokenCardSyn(code, text))                                          mechanicCounters[V_TOKEN_CARD]->increaseSyn(code);
-    if(isComboSyn(code, referencedTags))                                    mechanicCounters[V_COMBO]->increaseSyn(code);
-    if(isWindfuryMinionSyn(code))                                           mechanicCounters[V_WINDFURY_MINION]->increaseSyn(code);
-    if(isAttackBuffSyn(code, mechanics, attack, cardType))                  mechanicCounters[V_ATTACK_BUFF]->increaseSyn(code);
-    if(isHealthBuffSyn(code))                                               mechanicCounters[V_HEALTH_BUFF]->increaseSyn(code);
-    if(isReturnSyn(code, mechanics, cardType, text))                        mechanicCounters[V_RETURN]->increaseSyn(code);
-    if(isStealthSyn(code))                                                  mechanicCounters[V_STEALTH]->increaseSyn(code);
-    if(isSpellDamageSyn(code, mechanics, cardType, text))                   mechanicCounters[V_SPELL_DAMAGE]->increaseSyn(code);
-    if(isEvolveSyn(code))                                                   mechanicCounters[V_EVOLVE]->increaseSyn(code);
-    if(isSpawnEnemySyn(code))                                               mechanicCounters[V_SPAWN_ENEMY]->increaseSyn(code);
-    if(isRestoreTargetMinionSyn(code))                                      mechanicCounters[V_RESTORE_TARGET_MINION]->increaseSyn(code);
-    if(isRestoreFriendlyHeroSyn(code))                                      mechanicCounters[V_RESTORE_FRIENDLY_HEROE]->increaseSyn(code);
-    if(isRestoreFriendlyMinionSyn(code))                                    mechanicCounters[V_RESTORE_FRIENDLY_MINION]->increaseSyn(code);
-    if(isLifestealMinionSyn(code))                                          mechanicCounters[V_LIFESTEAL_MINION]->increaseSyn(code);
-    if(isArmorSyn(code))                                                    mechanicCounters[V_ARMOR]->increaseSyn(code);
-    if(isEnrageSyn(code, text))                                             mechanicCounters[V_ENRAGED]->increaseSyn(code);
-    if(isEggSyn(code, text))                                                mechanicCounters[V_EGG]->increaseSyn(code);
-    if(isDamageFriendlyHeroSyn(code))                                       mechanicCounters[V_DAMAGE_FRIENDLY_HERO]->increaseSyn(code);
-    if(isTauntSyn(code))                                                    mechanicCounters[V_TAUNT]->increaseSyn(code);
-    else if(isTauntAllSyn(code))                                            mechanicCounters[V_TAUNT_ALL]->increaseSyn(code);
-    if(isDeathrattleSyn(code))                                              mechanicCounters[V_DEATHRATTLE]->increaseSyn(code);
-    else if(isDeathrattleGoodAllSyn(code))                                  mechanicCounters[V_DEATHRATTLE_GOOD_ALL]->increaseSyn(code);
-    if(isDivineShieldSyn(code))                                             mechanicCounters[V_DIVINE_SHIELD]->increaseSyn(code);
-    else if(isDivineShieldAllSyn(code))                                     mechanicCounters[V_DIVINE_SHIELD_ALL]->increaseSyn(code);
-    if(isSecretSyn(code))                                                   mechanicCounters[V_SECRET]->increaseSyn(code);
-    else if(isSecretAllSyn(code, referencedTags))                           mechanicCounters[V_SECRET_ALL]->increaseSyn(code);
-    if(isEchoSyn(code))                                                     mechanicCounters[V_ECHO]->increaseSyn(code);
-    else if(isEchoAllSyn(code))                                             mechanicCounters[V_ECHO_ALL]->increaseSyn(code);
-    if(isRushSyn(code))                                                     mechanicCounters[V_RUSH]->increaseSyn(code);
-    else if(isRushAllSyn(code))                                             mechanicCounters[V_RUSH_ALL]->increaseSyn(code);
-    if(isMagneticSyn(code))                                                 mechanicCounters[V_MAGNETIC]->increaseSyn(code);
-    else if(isMagneticAllSyn(code))                                         mechanicCounters[V_MAGNETIC_ALL]->increaseSyn(code);
+    if(flags.mechanicGen.testBit(V_DISCOVER_DRAW))  drawList.append(code);
+    if(flags.mechanicGen.testBit(V_AOE))            aoeList.append(code);
+    if(flags.mechanicGen.testBit(V_PING))           pingList.append(code);
+    if(flags.mechanicGen.testBit(V_DAMAGE))         damageList.append(code);
+    if(flags.mechanicGen.testBit(V_DESTROY))        destroyList.append(code);
+    if(flags.mechanicGen.testBit(V_REACH))          reachList.append(code);
+    if(flags.mechanicGen.testBit(V_SURVIVABILITY))  survivabilityList.append(code);
+    if(flags.mechanicGen.testBit(V_TAUNT_ALL))      tauntList.append(code);
+    discover = flags.discover;
+    draw = flags.draw;
+    toYourHand = flags.toYourHand;
 }
 
 
@@ -785,8 +751,7 @@ void SynergyHandler::updateStatsCards(DeckCard &deckCard)
 //    }
 
     //Synergies
-    QList<StatSyn> statSyns = StatSynergies::getStatsSynergiesFromJson(code, synergyCodes);
-    for(const StatSyn &statSyn: statSyns)
+    for(const StatSyn &statSyn: getSynergyFlags(code).statSyns)
     {
         switch(statSyn.cardType)
         {
@@ -860,278 +825,73 @@ void SynergyHandler::getSynergies(DeckCard &deckCard, QMap<QString,int> &synergi
 
 void SynergyHandler::getCardTypeSynergies(DeckCard &deckCard, QMap<QString,int> &synergies)
 {
-    QString code = deckCard.getCode();
-    QString text = Utility::cardEnTextFromCode(code).toLower();
-    CardType cardType = deckCard.getType();
+    const SynergyFlags &flags = getSynergyFlags(deckCard.getCode());
 
-    //Evita mostrar spellSyn cards en cada hechizo que veamos
-//    if(cardType == SPELL)
-//    {
-//        cardTypeCounters[V_SPELL]->insertSynCards(synergies);
-//        cardTypeCounters[V_SPELL_ALL]->insertSynCards(synergies);
-//    }
-//    else if(isSpellGen(code))                   cardTypeCounters[V_SPELL_ALL]->insertSynCards(synergies);
-    if(cardType == WEAPON)
+    for(int i=0; i<V_NUM_TYPES; i++)
     {
-        cardTypeCounters[V_WEAPON]->insertSynCards(synergies);
-        cardTypeCounters[V_WEAPON_ALL]->insertSynCards(synergies);
+        //Evita mostrar spellSyn cards en cada hechizo que veamos
+        if(flags.typeGen.testBit(i) && i != V_SPELL && i != V_SPELL_ALL && i != V_MINION)
+            cardTypeCounters[i]->insertSynCards(synergies);
+        if(flags.typeSyn.testBit(i))    cardTypeCounters[i]->insertCards(synergies);
     }
-    else if(isWeaponGen(code, text))            cardTypeCounters[V_WEAPON_ALL]->insertSynCards(synergies);
-
-
-    if(isSpellSyn(code))                        cardTypeCounters[V_SPELL]->insertCards(synergies);
-    else if(isSpellAllSyn(code, text))          cardTypeCounters[V_SPELL_ALL]->insertCards(synergies);
-    if(isWeaponSyn(code))                       cardTypeCounters[V_WEAPON]->insertCards(synergies);
-    else if(isWeaponAllSyn(code, text))         cardTypeCounters[V_WEAPON_ALL]->insertCards(synergies);
 }
 
 
 void SynergyHandler::getRaceSynergies(DeckCard &deckCard, QMap<QString,int> &synergies)
 {
-    QString code = deckCard.getCode();
-    QString text = Utility::cardEnTextFromCode(code).toLower();
-    CardRace cardRace = deckCard.getRace();
-    QJsonArray mechanics = Utility::getCardAttribute(code, "mechanics").toArray();
+    const SynergyFlags &flags = getSynergyFlags(deckCard.getCode());
 
-    if(cardRace == MURLOC)
-    {
-        raceCounters[V_MURLOC]->insertSynCards(synergies);
-        raceCounters[V_MURLOC_ALL]->insertSynCards(synergies);
-    }
-    else if(isMurlocGen(code))      raceCounters[V_MURLOC_ALL]->insertSynCards(synergies);
-    if(cardRace == DEMON)
-    {
-        raceCounters[V_DEMON]->insertSynCards(synergies);
-        raceCounters[V_DEMON_ALL]->insertSynCards(synergies);
-    }
-    else if(isDemonGen(code))       raceCounters[V_DEMON_ALL]->insertSynCards(synergies);
-    if(cardRace == MECHANICAL)
-    {
-        raceCounters[V_MECHANICAL]->insertSynCards(synergies);
-        raceCounters[V_MECHANICAL_ALL]->insertSynCards(synergies);
-    }
-    else if(isMechGen(code))        raceCounters[V_MECHANICAL_ALL]->insertSynCards(synergies);
-    if(cardRace == ELEMENTAL)
-    {
-        raceCounters[V_ELEMENTAL]->insertSynCards(synergies);
-        raceCounters[V_ELEMENTAL_ALL]->insertSynCards(synergies);
-    }
-    else if(isElementalGen(code))   raceCounters[V_ELEMENTAL_ALL]->insertSynCards(synergies);
-    if(cardRace == BEAST)
-    {
-        raceCounters[V_BEAST]->insertSynCards(synergies);
-        raceCounters[V_BEAST_ALL]->insertSynCards(synergies);
-    }
-    else if(isBeastGen(code))       raceCounters[V_BEAST_ALL]->insertSynCards(synergies);
-    if(cardRace == TOTEM)
-    {
-        raceCounters[V_TOTEM]->insertSynCards(synergies);
-        raceCounters[V_TOTEM_ALL]->insertSynCards(synergies);
-    }
-    else if(isTotemGen(code))       raceCounters[V_TOTEM_ALL]->insertSynCards(synergies);
-    if(cardRace == PIRATE)
-    {
-        raceCounters[V_PIRATE]->insertSynCards(synergies);
-        raceCounters[V_PIRATE_ALL]->insertSynCards(synergies);
-    }
-    else if(isPirateGen(code))      raceCounters[V_PIRATE_ALL]->insertSynCards(synergies);
-    if(cardRace == DRAGON)
+    for(int i=0; i<V_NUM_RACES; i++)
     {
-        raceCounters[V_DRAGON]->insertSynCards(synergies);
-        raceCounters[V_DRAGON_ALL]->insertSynCards(synergies);
+        if(flags.raceGen.testBit(i))    raceCounters[i]->insertSynCards(synergies);
+        if(flags.raceSyn.testBit(i))    raceCounters[i]->insertCards(synergies);
     }
-    else if(isDragonGen(code))      raceCounters[V_DRAGON_ALL]->insertSynCards(synergies);
-
-    if(isMurlocSyn(code))                           raceCounters[V_MURLOC]->insertCards(synergies);
-    else if(isMurlocAllSyn(code, text))             raceCounters[V_MURLOC_ALL]->insertCards(synergies);
-    if(isDemonSyn(code))                            raceCounters[V_DEMON]->insertCards(synergies);
-    else if(isDemonAllSyn(code, text))              raceCounters[V_DEMON_ALL]->insertCards(synergies);
-    if(isMechSyn(code))                             raceCounters[V_MECHANICAL]->insertCards(synergies);
-    else if(isMechAllSyn(code, mechanics, text))    raceCounters[V_MECHANICAL_ALL]->insertCards(synergies);
-    if(isElementalSyn(code))                        raceCounters[V_ELEMENTAL]->insertCards(synergies);
-    else if(isElementalAllSyn(code, text))          raceCounters[V_ELEMENTAL_ALL]->insertCards(synergies);
-    if(isBeastSyn(code))                            raceCounters[V_BEAST]->insertCards(synergies);
-    else if(isBeastAllSyn(code, text))              raceCounters[V_BEAST_ALL]->insertCards(synergies);
-    if(isTotemSyn(code))                            raceCounters[V_TOTEM]->insertCards(synergies);
-    else if(isTotemAllSyn(code, text))              raceCounters[V_TOTEM_ALL]->insertCards(synergies);
-    if(isPirateSyn(code))                           raceCounters[V_PIRATE]->insertCards(synergies);
-    else if(isPirateAllSyn(code, text))             raceCounters[V_PIRATE_ALL]->insertCards(synergies);
-    if(isDragonSyn(code, text))                     raceCounters[V_DRAGON]->insertCards(synergies);
-    else if(isDragonAllSyn(code))                   raceCounters[V_DRAGON_ALL]->insertCards(synergies);
 }
 
 
 void SynergyHandler::getMechanicSynergies(DeckCard &deckCard, QMap<QString,int> &synergies, QMap<QString, int> &mechanicIcons)
 {
-    QString code = deckCard.getCode();
-    QJsonArray mechanics = Utility::getCardAttribute(code, "mechanics").toArray();
-    QJsonArray referencedTags = Utility::getCardAttribute(code, "referencedTags").toArray();
-    QString text = Utility::cardEnTextFromCode(code).toLower();
-    CardType cardType = deckCard.getType();
-    int attack = Utility::getCardAttribute(code, "attack").toInt();
-    int cost = deckCard.getCost();
-    bool addRestoreIcon = false;
+    const SynergyFlags &flags = getSynergyFlags(deckCard.getCode());
+    const QBitArray &gen = flags.mechanicGen;
 
     //GEN
-    if(isDiscoverDrawGen(code, mechanics, referencedTags, text))
-    {
-        mechanicIcons[ThemeHandler::drawMechanicFile()] = mechanicCounters[V_DISCOVER_DRAW]->count() + 1;
-    }
-    if(isTaunt(code, mechanics))
-    {
-        mechanicCounters[V_TAUNT]->insertSynCards(synergies);
-        mechanicCounters[V_TAUNT_ALL]->insertSynCards(synergies);
-        mechanicIcons[ThemeHandler::tauntMechanicFile()] = mechanicCounters[V_TAUNT_ALL]->count() + 1;
-    }
-    else if(isTauntGen(code, referencedTags))
-    {
-        mechanicCounters[V_TAUNT_ALL]->insertSynCards(synergies);
-        mechanicIcons[ThemeHandler::tauntMechanicFile()] = mechanicCounters[V_TAUNT_ALL]->count() + 1;
-    }
-    if(isAoeGen(code, text))
-    {
-        mechanicCounters[V_AOE]->insertSynCards(synergies);
-        mechanicIcons[ThemeHandler::aoeMechanicFile()] = mechanicCounters[V_AOE]->count() + 1;
-    }
-    if(isPingGen(code, mechanics, referencedTags, text, cardType, attack))
-    {
-        mechanicCounters[V_PING]->insertSynCards(synergies);
-        mechanicIcons[ThemeHandler::pingMechanicFile()] = mechanicCounters[V_PING]->count() + 1;
-    }
-    if(isDamageMinionsGen(code, mechanics, referencedTags, text, cardType, attack))
-    {
-        mechanicIcons[ThemeHandler::damageMechanicFile()] = mechanicCounters[V_DAMAGE]->count() + 1;
-    }
-    if(isDestroyGen(code, mechanics, text))
-    {
-        mechanicIcons[ThemeHandler::destroyMechanicFile()] = mechanicCounters[V_DESTROY]->count() + 1;
-    }
-    if(isReachGen(code, mechanics, referencedTags, text, cardType, attack))
-    {
-        mechanicIcons[ThemeHandler::reachMechanicFile()] = mechanicCounters[V_REACH]->count() + 1;
-    }
-    if(isArmorGen(code, text))
-    {
-        mechanicCounters[V_ARMOR]->insertSynCards(synergies);
-        addRestoreIcon = true;
-    }
-    if(isRestoreFriendlyHeroGen(code, mechanics, text))
-    {
-        mechanicCounters[V_RESTORE_FRIENDLY_HEROE]->insertSynCards(synergies);
-        addRestoreIcon = true;
-    }
-    if(addRestoreIcon)
-    {
-        mechanicIcons[ThemeHandler::survivalMechanicFile()] = mechanicCounters[V_SURVIVABILITY]->count() + 1;
-    }
-    if(isRestoreTargetMinionGen(code, text))                    mechanicCounters[V_RESTORE_TARGET_MINION]->insertSynCards(synergies);
-    if(isRestoreFriendlyMinionGen(code, text))                  mechanicCounters[V_RESTORE_FRIENDLY_MINION]->insertSynCards(synergies);
-    if(isLifestealMinon(code, mechanics, cardType))             mechanicCounters[V_LIFESTEAL_MINION]->insertSynCards(synergies);
-    if(isJadeGolemGen(code, mechanics, referencedTags))         mechanicCounters[V_JADE_GOLEM]->insertCards(synergies);//Sinergias gen-gen
-    if(isDiscoverGen(code, mechanics, referencedTags))          mechanicCounters[V_DISCOVER]->insertSynCards(synergies);
-    if(isDrawGen(code, text))                                   mechanicCounters[V_DRAW]->insertSynCards(synergies);
-    if(isToYourHandGen(code, text))                             mechanicCounters[V_TOYOURHAND]->insertSynCards(synergies);
-    if(isOverload(code))                                        mechanicCounters[V_OVERLOAD]->insertSynCards(synergies);
-    if(isFreezeEnemyGen(code, mechanics, referencedTags, text)) mechanicCounters[V_FREEZE_ENEMY]->insertSynCards(synergies);
-    if(isDiscardGen(code, text))                                mechanicCounters[V_DISCARD]->insertSynCards(synergies);
-    if(isDeathrattleMinion(code, mechanics, cardType))          mechanicCounters[V_DEATHRATTLE]->insertSynCards(synergies);
-    if(isDeathrattleGoodAll(code, mechanics, referencedTags, cardType)) mechanicCounters[V_DEATHRATTLE_GOOD_ALL]->insertSynCards(synergies);
-    if(isBattlecry(code, mechanics))                            mechanicCounters[V_BATTLECRY]->insertSynCards(synergies);
-    if(isSilenceOwnGen(code, mechanics, referencedTags))        mechanicCounters[V_SILENCE]->insertSynCards(synergies);
-    if(isTauntGiverGen(code))                                   mechanicCounters[V_TAUNT_GIVER]->insertSynCards(synergies);
-    if(isTokenGen(code, text))                                  mechanicCounters[V_TOKEN]->insertSynCards(synergies);
-    if(isTokenCardGen(code, cost))                              mechanicCounters[V_TOKEN_CARD]->insertSynCards(synergies);
-    if(isComboGen(code, mechanics))                             mechanicCounters[V_COMBO]->insertSynCards(synergies);
-    if(isWindfuryMinion(code, mechanics, cardType))             mechanicCounters[V_WINDFURY_MINION]->insertSynCards(synergies);
-    if(isAttackBuffGen(code, text))                             mechanicCounters[V_ATTACK_BUFF]->insertSynCards(synergies);
-    if(isHealthBuffGen(code, text))                             mechanicCounters[V_HEALTH_BUFF]->insertSynCards(synergies);
-    if(isReturnGen(code, text))                                 mechanicCounters[V_RETURN]->insertSynCards(synergies);
-    if(isStealthGen(code, mechanics))                           mechanicCounters[V_STEALTH]->insertSynCards(synergies);
-    if(isSpellDamageGen(code))                                  mechanicCounters[V_SPELL_DAMAGE]->insertSynCards(synergies);
-    if(isEvolveGen(code, text))                                 mechanicCounters[V_EVOLVE]->insertSynCards(synergies);
-    if(isSpawnEnemyGen(code, text))                             mechanicCounters[V_SPAWN_ENEMY]->insertSynCards(synergies);
-    if(isEnrageGen(code, mechanics))                            mechanicCounters[V_ENRAGED]->insertSynCards(synergies);
-    if(isEggGen(code, mechanics, attack, cardType))             mechanicCounters[V_EGG]->insertSynCards(synergies);
-    if(isDamageFriendlyHeroGen(code))                           mechanicCounters[V_DAMAGE_FRIENDLY_HERO]->insertSynCards(synergies);
-    if(isDivineShield(code, mechanics))
-    {
-        mechanicCounters[V_DIVINE_SHIELD]->insertSynCards(synergies);
-        mechanicCounters[V_DIVINE_SHIELD_ALL]->insertSynCards(synergies);
-    }
-    else if(isDivineShieldGen(code, referencedTags))            mechanicCounters[V_DIVINE_SHIELD_ALL]->insertSynCards(synergies);
-
-    if(isSecret(code, mechanics))
-    {
-        mechanicCounters[V_SECRET]->insertSynCards(synergies);
-        mechanicCounters[V_SECRET_ALL]->insertSynCards(synergies);
-    }
-    else if(isSecretGen(code))                                  mechanicCounters[V_SECRET_ALL]->insertSynCards(synergies);
-    if(isEcho(code, text))
-    {
-        mechanicCounters[V_ECHO]->insertSynCards(synergies);
-        mechanicCounters[V_ECHO_ALL]->insertSynCards(synergies);
-    }
-    else if(isEchoGen(code))                                    mechanicCounters[V_ECHO_ALL]->insertSynCards(synergies);
-    if(isRush(code, text))
-    {
-        mechanicCounters[V_RUSH]->insertSynCards(synergies);
-        mechanicCounters[V_RUSH_ALL]->insertSynCards(synergies);
-    }
-    else if(isRushGen(code))                                    mechanicCounters[V_RUSH_ALL]->insertSynCards(synergies);
-    if(isMagnetic(code, mechanics))
+    for(int i=0; i<V_NUM_MECHANICS; i++)
     {
-        mechanicCounters[V_MAGNETIC]->insertSynCards(synergies);
-        mechanicCounters[V_MAGNETIC_ALL]->insertSynCards(synergies);
+        if(!gen.testBit(i)) continue;
+        switch(i)
+        {
+            //Solo icono
+            case V_DISCOVER_DRAW:
+            case V_DAMAGE:
+            case V_DESTROY:
+            case V_REACH:
+            case V_SURVIVABILITY:
+            break;
+            //Sinergias gen-gen
+            case V_JADE_GOLEM:
+                mechanicCounters[i]->insertCards(synergies);
+            break;
+            default:
+                mechanicCounters[i]->insertSynCards(synergies);
+            break;
+        }
     }
-    else if(isMagneticGen(code))                                mechanicCounters[V_MAGNETIC_ALL]->insertSynCards(synergies);
 
+    if(gen.testBit(V_DISCOVER_DRAW))    mechanicIcons[ThemeHandler::drawMechanicFile()] = mechanicCounters[V_DISCOVER_DRAW]->count() + 1;
+    if(gen.testBit(V_TAUNT_ALL))        mechanicIcons[ThemeHandler::tauntMechanicFile()] = mechanicCounters[V_TAUNT_ALL]->count() + 1;
+    if(gen.testBit(V_AOE))              mechanicIcons[ThemeHandler::aoeMechanicFile()] = mechanicCounters[V_AOE]->count() + 1;
+    if(gen.testBit(V_PING))             mechanicIcons[ThemeHandler::pingMechanicFile()] = mechanicCounters[V_PING]->count() + 1;
+    if(gen.testBit(V_DAMAGE))           mechanicIcons[ThemeHandler::damageMechanicFile()] = mechanicCounters[V_DAMAGE]->count() + 1;
+    if(gen.testBit(V_DESTROY))          mechanicIcons[ThemeHandler::destroyMechanicFile()] = mechanicCounters[V_DESTROY]->count() + 1;
+    if(gen.testBit(V_REACH))            mechanicIcons[ThemeHandler::reachMechanicFile()] = mechanicCounters[V_REACH]->count() + 1;
+    if(gen.testBit(V_SURVIVABILITY))    mechanicIcons[ThemeHandler::survivalMechanicFile()] = mechanicCounters[V_SURVIVABILITY]->count() + 1;
 
     //SYN
-    if(isAoeSyn(code))                                          mechanicCounters[V_AOE]->insertCards(synergies);
-    if(isPingSyn(code))                                         mechanicCounters[V_PING]->insertCards(synergies);
-    if(isDiscoverSyn(code))                                     mechanicCounters[V_DISCOVER]->insertCards(synergies);
-    if(isDrawSyn(code))                                         mechanicCounters[V_DRAW]->insertCards(synergies);
-    if(isToYourHandSyn(code))                                   mechanicCounters[V_TOYOURHAND]->insertCards(synergies);
-    if(isOverloadSyn(code, text))                               mechanicCounters[V_OVERLOAD]->insertCards(synergies);
-    if(isFreezeEnemySyn(code, referencedTags, text))            mechanicCounters[V_FREEZE_ENEMY]->insertCards(synergies);
-    if(isDiscardSyn(code, text))                                mechanicCounters[V_DISCARD]->insertCards(synergies);
-    if(isBattlecrySyn(code, referencedTags))                    mechanicCounters[V_BATTLECRY]->insertCards(synergies);
-    if(isSilenceOwnSyn(code, mechanics))                        mechanicCounters[V_SILENCE]->insertCards(synergies);
-    if(isTauntGiverSyn(code, mechanics, attack, cardType))      mechanicCounters[V_TAUNT_GIVER]->insertCards(synergies);
-    if(isTokenSyn(code, text))                                  mechanicCounters[V_TOKEN]->insertCards(synergies);
-    if(isTokenCardSyn(code, text))                              mechanicCounters[V_TOKEN_CARD]->insertCards(synergies);
-    if(isComboSyn(code, referencedTags))                        mechanicCounters[V_COMBO]->insertCards(synergies);
-    if(isWindfuryMinionSyn(code))                               mechanicCounters[V_WINDFURY_MINION]->insertCards(synergies);
-    if(isAttackBuffSyn(code, mechanics, attack, cardType))      mechanicCounters[V_ATTACK_BUFF]->insertCards(synergies);
-    if(isHealthBuffSyn(code))                                   mechanicCounters[V_HEALTH_BUFF]->insertCards(synergies);
-    //returnSyn es synergia debil
-//    if(isReturnSyn(code, mechanics, cardType, text))            mechanicCounters[V_RETURN]->insertCards(synergies);
-    if(isStealthSyn(code))                                      mechanicCounters[V_STEALTH]->insertCards(synergies);
-    if(isSpellDamageSyn(code, mechanics, cardType, text))       mechanicCounters[V_SPELL_DAMAGE]->insertCards(synergies);
-    if(isEvolveSyn(code))                                       mechanicCounters[V_EVOLVE]->insertCards(synergies);
-    if(isSpawnEnemySyn(code))                                   mechanicCounters[V_SPAWN_ENEMY]->insertCards(synergies);
-    if(isRestoreTargetMinionSyn(code))                          mechanicCounters[V_RESTORE_TARGET_MINION]->insertCards(synergies);
-    if(isRestoreFriendlyHeroSyn(code))                          mechanicCounters[V_RESTORE_FRIENDLY_HEROE]->insertCards(synergies);
-    if(isRestoreFriendlyMinionSyn(code))                        mechanicCounters[V_RESTORE_FRIENDLY_MINION]->insertCards(synergies);
-    if(isArmorSyn(code))                                        mechanicCounters[V_ARMOR]->insertCards(synergies);
-    if(isLifestealMinionSyn(code))                              mechanicCounters[V_LIFESTEAL_MINION]->insertCards(synergies);
-    if(isEnrageSyn(code, text))                                 mechanicCounters[V_ENRAGED]->insertCards(synergies);
-    if(isEggSyn(code, text))                                    mechanicCounters[V_EGG]->insertCards(synergies);
-    if(isDamageFriendlyHeroSyn(code))                           mechanicCounters[V_DAMAGE_FRIENDLY_HERO]->insertCards(synergies);
-    if(isTauntSyn(code))                                        mechanicCounters[V_TAUNT]->insertCards(synergies);
-    else if(isTauntAllSyn(code))                                mechanicCounters[V_TAUNT_ALL]->insertCards(synergies);
-    if(isDeathrattleSyn(code))                                  mechanicCounters[V_DEATHRATTLE]->insertCards(synergies);
-    else if(isDeathrattleGoodAllSyn(code))                      mechanicCounters[V_DEATHRATTLE_GOOD_ALL]->insertCards(synergies);
-    if(isDivineShieldSyn(code))                                 mechanicCounters[V_DIVINE_SHIELD]->insertCards(synergies);
-    else if(isDivineShieldAllSyn(code))                         mechanicCounters[V_DIVINE_SHIELD_ALL]->insertCards(synergies);
-    if(isSecretSyn(code))                                       mechanicCounters[V_SECRET]->insertCards(synergies);
-    else if(isSecretAllSyn(code, referencedTags))               mechanicCounters[V_SECRET_ALL]->insertCards(synergies);
-    if(isEchoSyn(code))                                         mechanicCounters[V_ECHO]->insertCards(synergies);
-    else if(isEchoAllSyn(code))                                 mechanicCounters[V_ECHO_ALL]->insertCards(synergies);
-    if(isRushSyn(code))                                         mechanicCounters[V_RUSH]->insertCards(synergies);
-    else if(isRushAllSyn(code))                                 mechanicCounters[V_RUSH_ALL]->insertCards(synergies);
-    if(isMagneticSyn(code))                                     mechanicCounters[V_MAGNETIC]->insertCards(synergies);
-    else if(isMagneticAllSyn(code))                             mechanicCounters[V_MAGNETIC_ALL]->insertCards(synergies);
+    for(int i=0; i<V_NUM_MECHANICS; i++)
+    {
+        //returnSyn es synergia debil
+        if(flags.mechanicSyn.testBit(i) && i != V_RETURN)   mechanicCounters[i]->insertCards(synergies);
+    }
 }
 
 
@@ -1183,8 +943,7 @@ void SynergyHandler::getStatsCardsSynergies(DeckCard &deckCard, QMap<QString,int
 //    }
 
     //Synergies
-    QList<StatSyn> statSyns = StatSynergies::getStatsSynergiesFromJson(code, synergyCodes);
-    for(const StatSyn &statSyn: statSyns)
+    for(const StatSyn &statSyn: getSynergyFlags(code).statSyns)
     {
         switch(statSyn.cardType)
         {
@@ -1239,6 +998,82 @@ void SynergyHandler::getStatsCardsSynergies(DeckCard &deckCard, QMap<QString,int
 }
 
 
+//Cartas de poolCodes con las que code tendria sinergia si estuvieran en el draft, sin necesidad de draft en curso.
+//Mismas reglas que getSynergies (cruce de bits Gen/Syn, direct links y stats).
+//Fuera de draft synergies.json no esta cargado (clearLists lo vacia), se carga aqui bajo demanda.
+QStringList SynergyHandler::getSynergyPartners(const QString &code, const QStringList &poolCodes)
+{
+    if(synergyCodes.isEmpty())  initSynergyCodes();
+
+    QStringList partners;
+    const SynergyFlags flags = getSynergyFlags(code);
+    const QList<QString> links = directLinks.value(code);
+
+    for(const QString &partnerCode: poolCodes)
+    {
+        if(links.contains(partnerCode) || isSynergyPartner(flags, getSynergyFlags(partnerCode)))
+        {
+            partners.append(partnerCode);
+        }
+    }
+    return partners;
+}
+
+
+//flags es la carta candidata, partnerFlags la carta ya en el draft (ver getSynergies/updateCounters).
+bool SynergyHandler::isSynergyPartner(const SynergyFlags &flags, const SynergyFlags &partnerFlags)
+{
+    if((flags.raceGen & partnerFlags.raceSyn).count(true) > 0)  return true;
+    if((flags.raceSyn & partnerFlags.raceGen).count(true) > 0)  return true;
+
+    QBitArray typeGen = flags.typeGen;
+    typeGen.clearBit(V_SPELL);
+    typeGen.clearBit(V_SPELL_ALL);
+    typeGen.clearBit(V_MINION);
+    if((typeGen & partnerFlags.typeSyn).count(true) > 0)        return true;
+    if((flags.typeSyn & partnerFlags.typeGen).count(true) > 0)  return true;
+
+    if(flags.mechanicGen.testBit(V_JADE_GOLEM) && partnerFlags.mechanicGen.testBit(V_JADE_GOLEM))  return true;
+    QBitArray mechanicGen = flags.mechanicGen;
+    mechanicGen.clearBit(V_DISCOVER_DRAW);
+    mechanicGen.clearBit(V_DAMAGE);
+    mechanicGen.clearBit(V_DESTROY);
+    mechanicGen.clearBit(V_REACH);
+    mechanicGen.clearBit(V_SURVIVABILITY);
+    mechanicGen.clearBit(V_JADE_GOLEM);
+    QBitArray mechanicSyn = flags.mechanicSyn;
+    mechanicSyn.clearBit(V_RETURN);
+    QBitArray partnerGen = partnerFlags.mechanicGen;
+    partnerGen.clearBit(V_TOKEN_CARD);
+    if((mechanicGen & partnerFlags.mechanicSyn).count(true) > 0)    return true;
+    if((mechanicSyn & partnerGen).count(true) > 0)                  return true;
+
+    return isStatSynergyPartner(flags, partnerFlags);
+}
+
+
+bool SynergyHandler::isStatSynergyPartner(const SynergyFlags &flags, const SynergyFlags &partnerFlags)
+{
+    for(const StatSyn &statSyn: flags.statSyns)
+    {
+        if(statSyn.isGen || statSyn.cardType == S_WEAPON)   continue;
+        for(const StatSyn &statPoint: partnerFlags.statPoints)
+        {
+            if(StatSynergies::isStatSynMatch(statSyn, statPoint))   return true;
+        }
+    }
+    for(const StatSyn &statSyn: partnerFlags.statSyns)
+    {
+        if(statSyn.isGen || statSyn.cardType == S_WEAPON)   continue;
+        for(const StatSyn &statPoint: flags.statPoints)
+        {
+            if(StatSynergies::isStatSynMatch(statSyn, statPoint))   return true;
+        }
+    }
+    return false;
+}
+
+
 void SynergyHandler::testSynergies()
 {
     initSynergyCodes();
@@ -1251,7 +1086,7 @@ void SynergyHandler::testSynergies()
         DeckCard deckCard(code);
         CardType cardType = deckCard.getType();
         CardClass cardClass = deckCard.getCardClass();
-        QString text = Utility::cardEnTextFromCode(code).toLower();
+        QString text = Utility::cardEnTextLowerFromCode(code);
         int attack = Utility::getCardAttribute(code, "attack").toInt();
         int cost = deckCard.getCost();
         QJsonArray mechanics = Utility::getCardAttribute(code, "mechanics").toArray();
@@ -1303,7 +1138,7 @@ void SynergyHandler::debugSynergiesCode(const QString &code, int num)
     if(synergyCodes.contains(code)) manual<<synergyCodes[code];
     DeckCard deckCard(code);
     CardType cardType = deckCard.getType();
-    QString text = Utility::cardEnTextFromCode(code).toLower();
+    QString text = Utility::cardEnTextLowerFromCode(code);
     int attack = Utility::getCardAttribute(code, "attack").toInt();
     int cost = deckCard.getCost();
     QJsonArray mechanics = Utility::getCardAttribute(code, "mechanics").toArray();
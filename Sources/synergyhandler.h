@@ -2,12 +2,25 @@
 #define SYNERGYHANDLER_H
 
 #include <QObject>
+#include <QBitArray>
 #include "Widgets/ui_extended.h"
 #include "Synergies/draftitemcounter.h"
 #include "Synergies/statsynergies.h"
 #include "utility.h"
 
 
+//Gen/Syn de una carta ya resueltos: un bit por counter (indices VisibleRace/VisibleType/VisibleMechanics).
+//Gen --> increase/insertSynCards, Syn --> increaseSyn/insertCards.
+class SynergyFlags
+{
+public:
+    QBitArray raceGen, raceSyn, typeGen, typeSyn, mechanicGen, mechanicSyn;
+    int discover, draw, toYourHand;
+    QList<StatSyn> statSyns;
+    QList<StatSyn> statPoints;  //Stats reales de la carta + statSyns Gen, para getSynergyPartners
+};
+
+
 class SynergyHandler : public QObject
 {
     Q_OBJECT
@@ -19,6 +32,7 @@ public:
 private:
     Ui::Extended *ui;
     QMap<QString, QList<QString>> synergyCodes, directLinks;
+    QHash<QString, SynergyFlags> synergyFlags;
     StatSynergies costMinions, attackMinions, healthMinions, costSpells;
 //    StatSynergies costWeapons, attackWeapons, healthWeapons;
     DraftItemCounter **raceCounters, **cardTypeCounters, **mechanicCounters;
@@ -37,8 +51,10 @@ public:
                         QStringList &aoeList, QStringList &tauntList, QStringList &survivabilityList, QStringList &drawList,
                         QStringList &pingList, QStringList &damageList, QStringList &destroyList, QStringList &reachList, int &draw, int &toYourHand, int &discover);
     void getSynergies(DeckCard &deckCard, QMap<QString, int> &synergies, QMap<QString, int> &mechanicIcons);
+    QStringList getSynergyPartners(const QString &code, const QStringList &poolCodes);
     void initSynergyCodes();
     void clearLists(bool keepCounters);
+    void clearSynergyFlags();
     int draftedCardsCount();
     void setTransparency(Transparency transparency, bool mouseInApp);
     void setTheme();
@@ -49,6 +65,10 @@ public:
 private:
     void createDraftItemCounters();
     void deleteDraftItemCounters();
+    const SynergyFlags &getSynergyFlags(const QString &code);
+    SynergyFlags computeSynergyFlags(const QString &code);
+    bool isSynergyPartner(const SynergyFlags &flags, const SynergyFlags &partnerFlags);
+    static bool isStatSynergyPartner(const SynergyFlags &flags, const SynergyFlags &partnerFlags);
 
     void updateManaCounter(DeckCard &deckCard);
     void updateRaceCounters(DeckCard &deckCard);
@@ -5,16 +5,17 @@
 #include "opencv2/core/core.hpp"
 #include "opencv2/features2d/features2d.hpp"
 #include "opencv2/highgui/highgui.hpp"
-#include "opencv2/nonfree/features2d.hpp"
 
 using namespace libzippp;
 using namespace std;
 
 
-QMap<QString, QJsonObject> * Utility::cardsJson = nullptr;
+QSharedPointer<const CardTable> Utility::cardTable(new CardTable());
+QMutex Utility::cardTableMutex;
 QString Utility::localLang = "enUS";
 QString Utility::diacriticLetters;
 QStringList Utility::noDiacriticLetters;
+int Utility::cardPixmapCropGeneration = 0;
 
 Utility::Utility()
 {
@@ -170,24 +171,31 @@ LoadingScreenState Utility::getLoadingScreenFromString(QString loadingScreenStri
 
 QString Utility::cardEnNameFromCode(QString code)
 {
-    return (*cardsJson)[code].value("name").toObject().value("enUS").toString();
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+    return cardTable->getEnName(cardTable->getId(code));
 }
 
 
 QString Utility::cardEnTextFromCode(QString code)
 {
-    return (*cardsJson)[code].value("text").toObject().value("enUS").toString();
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+    return cardTable->getEnText(cardTable->getId(code));
+}
+
+
+QString Utility::cardEnTextLowerFromCode(QString code)
+{
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+    return cardTable->getEnTextLower(cardTable->getId(code));
 }
 
 
 QString Utility::cardEnCodeFromName(QString name, bool onlyCollectible)
 {
-    for (QMap<QString, QJsonObject>::const_iterator it = cardsJson->cbegin(); it != cardsJson->cend(); it++)
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+    for(int id: cardTable->getIdsFromEnName(name))
     {
-        if(it->value("name").toObject().value("enUS").toString() == name)
-        {
-            if(!onlyCollectible || it->value("collectible").toBool())    return it.key();
-        }
+        if(!onlyCollectible || cardTable->isCollectible(id))  return cardTable->getCode(id);
     }
 
     return "";
@@ -196,51 +204,44 @@ QString Utility::cardEnCodeFromName(QString name, bool onlyCollectible)
 
 QString Utility::cardLocalCodeFromName(QString name)
 {
-    for (QMap<QString, QJsonObject>::const_iterator it = cardsJson->cbegin(); it != cardsJson->cend(); it++)
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+    for(int id: cardTable->getIdsFromLocalName(name))
     {
-        if(it->value("name").toObject().value(localLang).toString() == name)
-        {
-            if(!it->value("cost").isUndefined())    return it.key();
-        }
+        if(cardTable->getCost(id) != CARD_NO_VALUE)  return cardTable->getCode(id);
     }
 
     return "";
 }
 
 
+//Codigos desconocidos devuelven Undefined.
 QJsonValue Utility::getCardAttribute(QString code, QString attribute)
 {
-    if(attribute == "text" || attribute == "name")
-    {
-        return (*cardsJson)[code].value(attribute).toObject().value(localLang);
-    }
-    else
-    {
-        return (*cardsJson)[code].value(attribute);
-    }
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+    return cardTable->getAttribute(cardTable->getId(code), attribute);
 }
 
 
+//dbfId y name usan los indices de cardTable, el resto de atributos recorren la tabla.
 QString Utility::getCodeFromCardAttribute(QString attribute, QJsonValue value)
 {
-    if(attribute == "text" || attribute == "name")
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+
+    if(attribute == "dbfId")
     {
-        for (QMap<QString, QJsonObject>::const_iterator it = cardsJson->cbegin(); it != cardsJson->cend(); it++)
-        {
-            if(it->value(attribute).toObject().value(localLang) == value)
-            {
-                return it.key();
-            }
-        }
+        return cardTable->getCode(cardTable->getIdFromDbfId(value.toInt()));
+    }
+    else if(attribute == "name")
+    {
+        QVector<int> ids = cardTable->getIdsFromLocalName(value.toString());
+        if(ids.isEmpty())   return "";
+        return cardTable->getCode(ids.first());
     }
     else
     {
-        for (QMap<QString, QJsonObject>::const_iterator it = cardsJson->cbegin(); it != cardsJson->cend(); it++)
+        for(int id=0; id<cardTable->count(); id++)
         {
-            if(it->value(attribute) == value)
-            {
-                return it.key();
-            }
+            if(cardTable->getAttribute(id, attribute) == value)     return cardTable->getCode(id);
         }
     }
 
@@ -250,154 +251,64 @@ QString Utility::getCodeFromCardAttribute(QString attribute, QJsonValue value)
 
 CardType Utility::getTypeFromCode(QString code)
 {
-    QString value = Utility::getCardAttribute(code, "type").toString();
-    if(value == "MINION")           return MINION;
-    else if(value == "SPELL")       return SPELL;
-    else if(value == "WEAPON")      return WEAPON;
-    else if(value == "ENCHANTMENT") return ENCHANTMENT;
-    else if(value == "HERO")        return HERO;
-    else if(value == "HERO_POWER")  return HERO_POWER;
-    else                            return INVALID_TYPE;
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+    return cardTable->getType(cardTable->getId(code));
 }
 
 
 CardRarity Utility::getRarityFromCode(QString code)
 {
-    QString value = Utility::getCardAttribute(code, "rarity").toString();
-    if(value == "FREE")             return COMMON;
-    else if(value == "COMMON")      return COMMON;
-    else if(value == "RARE")        return RARE;
-    else if(value == "EPIC")        return EPIC;
-    else if(value == "LEGENDARY")   return LEGENDARY;
-    else                            return INVALID_RARITY;
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+    return cardTable->getRarity(cardTable->getId(code));
 }
 
 
 CardRace Utility::getRaceFromCode(QString code)
 {
-    QString value = Utility::getCardAttribute(code, "race").toString();
-    if(value == "BLOODELF")         return BLOODELF;
-    else if(value == "DRAENEI")     return DRAENEI;
-    else if(value == "DWARF")       return DWARF;
-    else if(value == "GNOME")       return GNOME;
-    else if(value == "GOBLIN")      return GOBLIN;
-    else if(value == "HUMAN")       return HUMAN;
-    else if(value == "NIGHTELF")    return NIGHTELF;
-    else if(value == "ORC")         return ORC;
-    else if(value == "TAUREN")      return TAUREN;
-    else if(value == "TROLL")       return TROLL;
-    else if(value == "UNDEAD")      return UNDEAD;
-    else if(value == "WORGEN")      return WORGEN;
-    else if(value == "GOBLIN2")     return GOBLIN2;
-    else if(value == "MURLOC")      return MURLOC;
-    else if(value == "DEMON")       return DEMON;
-    else if(value == "SCOURGE")     return SCOURGE;
-    else if(value == "MECHANICAL")  return MECHANICAL;
-    else if(value == "ELEMENTAL")   return ELEMENTAL;
-    else if(value == "OGRE")        return OGRE;
-    else if(value == "BEAST")       return BEAST;
-    else if(value == "TOTEM")       return TOTEM;
-    else if(value == "NERUBIAN")    return NERUBIAN;
-    else if(value == "PIRATE")      return PIRATE;
-    else if(value == "DRAGON")      return DRAGON;
-    else                            return INVALID_RACE;
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+    return cardTable->getRace(cardTable->getId(code));
 }
 
 
 CardClass Utility::getClassFromCode(QString code)
 {
-    QString value = Utility::getCardAttribute(code, "cardClass").toString();
-    if(value == "")             return NEUTRAL;
-    else if(value == "NEUTRAL") return NEUTRAL;
-    else if(value == "DRUID")   return DRUID;
-    else if(value == "HUNTER")  return HUNTER;
-    else if(value == "MAGE")    return MAGE;
-    else if(value == "PALADIN") return PALADIN;
-    else if(value == "PRIEST")  return PRIEST;
-    else if(value == "ROGUE")   return ROGUE;
-    else if(value == "SHAMAN")  return SHAMAN;
-    else if(value == "WARLOCK") return WARLOCK;
-    else if(value == "WARRIOR") return WARRIOR;
-    else if(value == "DREAM")   return DREAM;
-    else                        return INVALID_CLASS;
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+    return cardTable->getClass(cardTable->getId(code));
 }
 
 
 bool Utility::isFromStandardSet(QString code)
 {
-    QString cardSet = getCardAttribute(code, "set").toString();
-
-    if( cardSet == "CORE" || cardSet == "EXPERT1" ||
-//        cardSet == "HOF" || cardSet == "NAXX" || cardSet == "GVG" ||
-//        cardSet == "BRM" || cardSet == "TGT" || cardSet == "LOE" ||
-//        cardSet == "OG" || cardSet == "KARA" || cardSet == "GANGS" ||
-        cardSet == "UNGORO" || cardSet == "ICECROWN" || cardSet == "LOOTAPALOOZA" ||
-        cardSet == "GILNEAS" || cardSet == "BOOMSDAY" || cardSet == "TROLL")
-    {
-        return true;
-    }
-    else
-    {
-        return false;
-    }
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+    return cardTable->isStandard(cardTable->getId(code));
 }
 
 
 bool Utility::isASecret(QString code)
 {
-    QJsonArray mechanics = getCardAttribute(code, "mechanics").toArray();
-
-    foreach(QJsonValue mechanic, mechanics)
-    {
-        if(mechanic.toString() == "SECRET") return true;
-    }
-    return false;
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+    return cardTable->isSecret(cardTable->getId(code));
 }
 
 
 QStringList Utility::getSetCodes(const QString &set, bool onlyCollectible)
 {
-    QStringList setCodes;
-    for(const QString &code: Utility::cardsJson->keys())
-    {
-        if(getCardAttribute(code, "set").toString() == set)
-        {
-            if(!onlyCollectible || getCardAttribute(code, "collectible").toBool())
-            {
-                setCodes.append(code);
-            }
-        }
-    }
-    return setCodes;
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+    return cardTable->getSetCodes(set, onlyCollectible);
 }
 
 
 QStringList Utility::getWildCodes()
 {
-    QStringList setCodes;
-    for(const QString &code: Utility::cardsJson->keys())
-    {
-        if(getCardAttribute(code, "collectible").toBool() == true)
-        {
-            setCodes.append(code);
-        }
-    }
-    return setCodes;
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+    return cardTable->getCollectibleCodes();
 }
 
 
 QStringList Utility::getStandardCodes()
 {
-    QStringList setCodes;
-    for(const QString &code: Utility::cardsJson->keys())
-    {
-        if(Utility::isFromStandardSet(code) &&
-            (getCardAttribute(code, "collectible").toBool() == true))
-        {
-            setCodes.append(code);
-        }
-    }
-    return setCodes;
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+    return cardTable->getStandardCodes();
 }
 
 
@@ -444,6 +355,41 @@ QString Utility::hscardsPath()
 }
 
 
+//Arte de cartas decodificado, compartido por todos los widgets mediante QPixmapCache (LRU limitado a CARD_PIXMAP_CACHE_KB).
+//Con crop se guarda tambien el recorte, la clave incluye cardPixmapCropGeneration (ver removeCardPixmap).
+//Los png que aun no existen no se cachean.
+QPixmap Utility::getCardPixmap(const QString &code, const QRect &crop)
+{
+    const QString key = "card/" + code;
+    const QString cropKey = crop.isNull()?key:("crop/" + QString::number(cardPixmapCropGeneration) + "/" + code + "/" +
+                                                QString::number(crop.x()) + "," + QString::number(crop.y()) + "," +
+                                                QString::number(crop.width()) + "," + QString::number(crop.height()));
+
+    QPixmap pixmap;
+    if(QPixmapCache::find(cropKey, &pixmap))    return pixmap;
+    if(!QPixmapCache::find(key, &pixmap))
+    {
+        pixmap = QPixmap(hscardsPath() + "/" + code + ".png");
+        if(pixmap.isNull()) return pixmap;
+        QPixmapCache::insert(key, pixmap);
+    }
+    if(crop.isNull())   return pixmap;
+
+    QPixmap cropPixmap = pixmap.copy(crop);
+    QPixmapCache::insert(cropKey, cropPixmap);
+    return cropPixmap;
+}
+
+
+//Se llama al descargar una imagen nueva de la carta.
+//Los recortes anteriores dejan de encontrarse y QPixmapCache los va descartando, igual que DeckCard::clearDrawCache.
+void Utility::removeCardPixmap(const QString &code)
+{
+    QPixmapCache::remove("card/" + code);
+    cardPixmapCropGeneration++;
+}
+
+
 QString Utility::extraPath()
 {
     return dataPath() + "/Extra";
@@ -456,15 +402,62 @@ QString Utility::themesPath()
 }
 
 
-void Utility::setCardsJson(QMap<QString, QJsonObject> *cardsJson)
+QSharedPointer<const CardTable> Utility::getCardTable()
+{
+    QMutexLocker locker(&cardTableMutex);
+    return cardTable;
+}
+
+
+void Utility::setCardTable(QSharedPointer<const CardTable> cardTable)
 {
-    Utility::cardsJson = cardsJson;
+    QMutexLocker locker(&cardTableMutex);
+    Utility::cardTable = cardTable;
+}
+
+
+//Se llama de nuevo cada vez que cards.json cambia para compilar un cardTable nuevo.
+//Quien este usando el anterior lo mantiene vivo hasta que suelta su QSharedPointer.
+void Utility::setCardsJson(const QJsonObject &cardsObject)
+{
+    QSharedPointer<CardTable> newCardTable(new CardTable());
+    newCardTable->build(cardsObject, localLang);
+    setCardTable(newCardTable);
+}
+
+
+bool Utility::loadCardsBin()
+{
+    QSharedPointer<CardTable> newCardTable(new CardTable());
+    if(!newCardTable->load(extraPath() + "/cards.bin", localLang))   return false;
+    setCardTable(newCardTable);
+    return true;
 }
 
 
-void Utility::setLocalLang(QString localLang)
+//Guarda el cardTable actual, que debe venir de cardsObject (setCardsJson), con los textos de todos los idiomas.
+//Si falla se borra cards.bin para no mezclarlo con un cardTable de otra version.
+bool Utility::saveCardsBin(const QJsonObject &cardsObject)
+{
+    const QString path = extraPath() + "/cards.bin";
+    if(getCardTable()->save(path, cardsObject))  return true;
+    QFile::remove(path);
+    return false;
+}
+
+
+//Copia del snapshot actual (las columnas se comparten) con los textos locales leidos de cards.bin.
+//Devuelve false si cards.bin no tiene ese idioma, hay que recompilar cardTable desde cards.json.
+bool Utility::setLocalLang(QString localLang)
 {
     Utility::localLang = localLang;
+    const QSharedPointer<const CardTable> cardTable = getCardTable();
+    if(cardTable->count() == 0)     return true;
+
+    QSharedPointer<CardTable> newCardTable(new CardTable(*cardTable));
+    if(!newCardTable->loadLocal(extraPath() + "/cards.bin", localLang))     return false;
+    setCardTable(newCardTable);
+    return true;
 }
 
 
@@ -496,102 +489,6 @@ QString Utility::removeAccents(QString s)
 }
 
 
-std::vector<Point2f> Utility::findTemplateOnScreen(QString templateImage, QScreen *screen, std::vector<Point2f> templatePoints, QPointF &screenScale)
-{
-    std::vector<Point2f> screenPoints;
-    QRect rect = screen->geometry();
-    QImage image = screen->grabWindow(0,rect.x(),rect.y(),rect.width(),rect.height()).toImage();
-
-    //Screen scale
-    screenScale.setX(rect.width() / static_cast<qreal>(image.width()));
-    screenScale.setY(rect.height() / static_cast<qreal>(image.height()));
-
-    cv::Mat mat(image.height(),image.width(),CV_8UC4,image.bits(), static_cast<size_t>(image.bytesPerLine()));
-    cv::Mat screenCapture = mat.clone();
-
-    Mat img_object = imread((Utility::extraPath() + "/" + templateImage).toStdString(), CV_LOAD_IMAGE_GRAYSCALE );
-    if(!img_object.data)
-    {
-        qDebug() << "Utility: Cannot find" << templateImage;
-        return screenPoints;
-    }
-    Mat img_scene;
-    cv::cvtColor(screenCapture, img_scene, CV_BGR2GRAY);
-
-    //-- Step 1: Detect the keypoints using SURF Detector
-    int minHessian = 400;
-
-    SurfFeatureDetector detector( minHessian );
-
-    std::vector<KeyPoint> keypoints_object, keypoints_scene;
-
-    detector.detect( img_object, keypoints_object );
-    detector.detect( img_scene, keypoints_scene );
-
-    //-- Step 2: Calculate descriptors (feature vectors)
-    SurfDescriptorExtractor extractor;
-
-    Mat descriptors_object, descriptors_scene;
-
-    extractor.compute( img_object, keypoints_object, descriptors_object );
-    extractor.compute( img_scene, keypoints_scene, descriptors_scene );
-
-    //-- Step 3: Matching descriptor vectors using FLANN matcher
-    FlannBasedMatcher matcher;
-    std::vector< DMatch > matches;
-    matcher.match( descriptors_object, descriptors_scene, matches );
-
-    double min_dist = 100;
-
-    //-- Quick calculation of max and min distances between keypoints
-    for( int i = 0; i < descriptors_object.rows; i++ )
-    { double dist = static_cast<double>(matches[static_cast<ulong>(i)].distance);
-      if( dist < min_dist ) min_dist = dist;
-    }
-
-    qDebug()<< "Utility: FLANN min dist:" <<min_dist;
-
-    //-- Draw only "good" matches (i.e. whose distance is less than 2*min_dist )
-    std::vector< DMatch > good_matches;
-
-    for( int i = 0; i < descriptors_object.rows; i++ )
-    { if( static_cast<double>(matches[static_cast<ulong>(i)].distance) < /*min(0.05,max(2*min_dist, 0.02))*/0.04 )
-       { good_matches.push_back( matches[static_cast<ulong>(i)]); }
-    }
-    qDebug()<< "Utility: FLANN Keypoints buenos:" <<good_matches.size();
-    if(good_matches.size() < 10)    return screenPoints;
-
-
-    //-- Localize the object (find homography)
-    std::vector<Point2f> obj;
-    std::vector<Point2f> scene;
-
-    for( uint i = 0; i < good_matches.size(); i++ )
-    {
-      //-- Get the keypoints from the good matches
-      obj.push_back( keypoints_object[ static_cast<ulong>(good_matches[i].queryIdx) ].pt );
-      scene.push_back( keypoints_scene[ static_cast<ulong>(good_matches[i].trainIdx) ].pt );
-    }
-
-    Mat H = findHomography( obj, scene, CV_RANSAC );
-
-    //-- Get the corners from the image_1 ( the object to be "detected" )
-    perspectiveTransform(templatePoints, screenPoints, H);
-
-    //Show matches
-    if(false)
-    {
-        Mat img_matches;
-        drawMatches( img_object, keypoints_object, img_scene, keypoints_scene,
-                     good_matches, img_matches, Scalar::all(-1), Scalar::all(-1),
-                     vector<char>(), DrawMatchesFlags::NOT_DRAW_SINGLE_POINTS );
-        imshow( "Good Matches & Object detection", img_matches );
-    }
-
-    return screenPoints;
-}
-
-
 QPropertyAnimation * Utility::fadeInWidget(QWidget * widget)
 {
     QGraphicsOpacityEffect *eff = static_cast<QGraphicsOpacityEffect *>(widget->graphicsEffect());
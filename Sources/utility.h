@@ -4,8 +4,11 @@
 #include "Cards/deckcard.h"
 #include "opencv2/opencv.hpp"
 #include "Utils/libzippp.h"
+#include "Utils/cardtable.h"
 #include <QString>
 #include <QMap>
+#include <QSharedPointer>
+#include <QMutex>
 #include <QJsonObject>
 #include <QUrlQuery>
 #include <QNetworkRequest>
@@ -26,6 +29,7 @@ using namespace cv;
 #define ANIMATION_TIME 750
 #define SHOW_EASING_CURVE QEasingCurve::OutCubic
 #define HIDE_EASING_CURVE QEasingCurve::InCubic
+#define CARD_PIXMAP_CACHE_KB 65536  //Limite de QPixmapCache (arte de cartas decodificado)
 
 enum DebugLevel { Normal, Warning, Error };
 enum Transparency { Transparent, AutoTransparent, Opaque, Framed };
@@ -70,13 +74,21 @@ public:
 
 //Variables
 private:
-    static QMap<QString, QJsonObject> *cardsJson;
+    //Snapshot inmutable, GameWatcher lo consulta desde el hilo de logs.
+    //Solo se sustituye entero bajo cardTableMutex, nunca se modifica.
+    static QSharedPointer<const CardTable> cardTable;
+    static QMutex cardTableMutex;
     static QString localLang;
     static QString diacriticLetters;
     static QStringList noDiacriticLetters;
+    static int cardPixmapCropGeneration;
 
 
 //Metodos
+private:
+    static QSharedPointer<const CardTable> getCardTable();
+    static void setCardTable(QSharedPointer<const CardTable> cardTable);
+
 public:
     static QString heroToLogNumber(const QString &hero);
     static QString heroToLogNumber(CardClass cardClass);
@@ -93,18 +105,22 @@ public:
     static QString dataPath();
     static QString gameslogPath();
     static QString hscardsPath();
+    static QPixmap getCardPixmap(const QString &code, const QRect &crop=QRect());
+    static void removeCardPixmap(const QString &code);
     static QString extraPath();
     static QString cardEnNameFromCode(QString code);
+    static QString cardEnTextLowerFromCode(QString code);
     static QString cardEnCodeFromName(QString name, bool onlyCollectible=true);
     static QString cardLocalCodeFromName(QString name);
-    static void setCardsJson(QMap<QString, QJsonObject> *cardsJson);
-    static void setLocalLang(QString localLang);
+    static void setCardsJson(const QJsonObject &cardsObject);
+    static bool loadCardsBin();
+    static bool saveCardsBin(const QJsonObject &cardsObject);
+    static bool setLocalLang(QString localLang);
     static QString removeAccents(QString s);
     static QPropertyAnimation *fadeInWidget(QWidget *widget);
     static QPropertyAnimation *fadeOutWidget(QWidget *widget);
     static QString getLoadingScreenToString(LoadingScreenState loadingScreen);
     static LoadingScreenState getLoadingScreenFromString(QString loadingScreenString);
-    static std::vector<Point2f> findTemplateOnScreen(QString templateImage, QScreen *screen, std::vector<Point2f> templatePoints, QPointF &screenScale);
     static QPixmap getTransformedImage(QPixmap image, QPointF pos, QPointF anchor, qreal rot, QPointF &origin);
     static bool isLeftOfScreen(QPoint center);
     static CardType getTypeFromCode(QString code);